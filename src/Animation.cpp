@@ -0,0 +1,23 @@
+// animation.cpp
+#include "Animation.h"
+#include <algorithm>
+
+ClipId AnimationSet::AddSheetRow(const char *name, const Sprite &sheet, int sheetRows, int sheetRow,
+                                 int frameCount, float frameDuration) {
+    frameCount = std::clamp(frameCount, 1, 255);
+    sheetRows = std::max(sheetRows, 1);
+
+    texture = sheet.texture;
+    float frameWidth = sheet.region.width / frameCount;
+    float frameHeight = sheet.region.height / sheetRows;
+
+    AnimationClip clip;
+    clip.name = name;
+    for (int i = 0; i < frameCount; ++i) {
+        clip.frames.push_back({sheet.region.x + i * frameWidth, sheet.region.y + sheetRow * frameHeight,
+                               frameWidth, frameHeight});
+        clip.durations.push_back(frameDuration);
+    }
+    clips.push_back(clip);
+    return (ClipId) (clips.size() - 1);
+}
@@ -0,0 +1,73 @@
+// animation.h
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "raylib.h"
+#include <vector>
+#include <cstdint>
+
+#include "Sprite.h"
+
+using ClipId = uint8_t;
+
+// Clip ids of the entity animation sets, in the order Simulation builds them
+const ClipId PLANT_CLIP_IDLE = 0;
+const ClipId ZOMBIE_CLIP_WALK = 0;
+const ClipId ZOMBIE_CLIP_EAT = 1; // Regular zombies only; jumping zombies walk the whole time
+
+//----------------------------------------------------------------------------------
+// Animation Clip / Set
+//----------------------------------------------------------------------------------
+// One named animation: the source rect of every frame, in texture pixels, and how long
+// each frame stays up.
+struct AnimationClip {
+    const char *name;
+    std::vector<Rectangle> frames;
+    std::vector<float> durations; // Seconds per frame
+};
+
+// Every clip cut from one sprite sheet. Built once per sheet, when the Simulation starts,
+// and shared by all entities of that type, so an entity only carries an AnimationState.
+class AnimationSet {
+public:
+    Texture2D texture = {};
+    std::vector<AnimationClip> clips;
+
+    // Adds a clip cut from one row of a sheet that is sheetRows rows of frameCount
+    // equal frames each; the new clip's id is its position in clips
+    ClipId AddSheetRow(const char *name, const Sprite &sheet, int sheetRows, int sheetRow,
+                       int frameCount, float frameDuration);
+
+    const AnimationClip &Clip(ClipId clip) const { return clips[clip]; }
+};
+
+//----------------------------------------------------------------------------------
+// Animation State
+//----------------------------------------------------------------------------------
+// Where one entity is in its animation. Advancing is a lookup into its set's tables.
+struct AnimationState {
+    ClipId clip = 0;
+    uint8_t frame = 0;
+    float time = 0.0f; // Seconds the current frame has been shown
+
+    // Starts clip from its first frame
+    void Play(ClipId next) {
+        clip = next;
+        frame = 0;
+        time = 0.0f;
+    }
+
+    // Moves on one frame once the current one has been up for its duration
+    void Advance(const AnimationSet &set, float deltaTime) {
+        const AnimationClip &current = set.Clip(clip);
+        time += deltaTime;
+        if (time >= current.durations[frame]) {
+            time = 0.0f;
+            frame = (uint8_t) ((frame + 1) % current.frames.size());
+        }
+    }
+
+    const Rectangle &FrameRect(const AnimationSet &set) const { return set.Clip(clip).frames[frame]; }
+};
+
+#endif // ANIMATION_H
@@ -0,0 +1,62 @@
+// board_config.h
+#ifndef BOARD_CONFIG_H
+#define BOARD_CONFIG_H
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include "GameConstants.h"
+
+//----------------------------------------------------------------------------------
+// Board Config
+//----------------------------------------------------------------------------------
+// Size and placement of the lawn in world coordinates. Every World carries one, so the
+// simulation and renderer read the layout from here rather than from the GRID_* globals,
+// which are now only the defaults for the standard 5x9 lawn.
+struct BoardConfig {
+    int rows = GRID_ROWS;
+    int cols = GRID_COLS;
+    int tileSize = TILE_SIZE;
+    float originX = (float) GRID_START_X; // Top-left corner of tile (0, 0)
+    float originY = (float) GRID_START_Y;
+    float fieldRight = (float) SCREEN_WIDTH; // Where zombies walk in and peas leave play
+
+    // A rows x cols board with the standard lawn's origin and the same strip of open
+    // ground between the last column and the zombies' entry point
+    static BoardConfig WithSize(int rows, int cols) {
+        BoardConfig board;
+        float entryMargin = board.fieldRight - board.Right();
+        board.rows = rows;
+        board.cols = cols;
+        board.fieldRight = board.Right() + entryMargin;
+        return board;
+    }
+
+    float Width() const { return (float) (cols * tileSize); }
+    float Height() const { return (float) (rows * tileSize); }
+    float Right() const { return originX + Width(); }
+    float Bottom() const { return originY + Height(); }
+
+    float TileX(int col) const { return originX + (float) (col * tileSize); }
+    float TileY(int row) const { return originY + (float) (row * tileSize); }
+
+    // The most peas one lane can have in flight: a Repeater on every tile, each pea flying
+    // from its tile to fieldRight. A lane's projectile store may grow up to this, so no
+    // shot is dropped in play, while one that never sees that load stays small.
+    size_t MaxLaneProjectiles() const {
+        size_t total = 0;
+        for (int col = 0; col < cols; ++col) {
+            float flightSeconds = (fieldRight - TileX(col)) / PROJECTILE_SPEED;
+            // +2: the pair fired on the tick its oldest pea is culled
+            total += (size_t) std::ceil(std::max(0.0f, flightSeconds) * PEA_MAX_SHOTS_PER_SECOND) + 2;
+        }
+        return std::max(total, (size_t) PROJECTILE_LANE_CAPACITY);
+    }
+
+    // The column or row under a world position; may be outside the board
+    int ColumnAt(float x) const { return (int) std::floor((x - originX) / tileSize); }
+    int RowAt(float y) const { return (int) std::floor((y - originY) / tileSize); }
+};
+
+#endif // BOARD_CONFIG_H
@@ -0,0 +1,30 @@
+// damage_events.cpp
+#include "DamageEvents.h"
+#include "Zombie.h"
+
+void DamageQueue::MarkPending() const {
+    for (const DamageEvent &event: events) {
+        event.target->pendingDamage += event.kill ? event.target->health : event.amount;
+    }
+}
+
+int DamageQueue::Commit() {
+    int score = 0;
+    for (const DamageEvent &event: events) {
+        Zombie *zombie = event.target;
+        zombie->pendingDamage = 0;
+        if (!zombie->active) continue; // Already finished off earlier in this commit
+
+        if (event.slow) {
+            zombie->ApplySlowEffect();
+        }
+        zombie->health = event.kill ? 0 : zombie->health - event.amount;
+
+        if (zombie->health <= 0) {
+            zombie->active = false;
+            score += zombie->scoreValue;
+        }
+    }
+    events.clear();
+    return score;
+}
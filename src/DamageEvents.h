@@ -0,0 +1,44 @@
+// damage_events.h
+#ifndef DAMAGE_EVENTS_H
+#define DAMAGE_EVENTS_H
+
+#include <vector>
+#include <cstddef>
+
+class Zombie;
+
+//----------------------------------------------------------------------------------
+// Damage Event Queue
+//----------------------------------------------------------------------------------
+// Everything that hurts a zombie during a tick (peas, Cherry Bombs, mowers) records an
+// event here instead of touching the zombie. Commit() then applies them all at the end of
+// the tick and is the only place zombies die and score is awarded, so a zombie is scored
+// exactly once and the producing phases only ever read zombie state.
+struct DamageEvent {
+    Zombie *target;
+    int amount;
+    bool slow; // Ice Pea hit: also apply the slow effect
+    bool kill; // Mower: dies whatever its health
+};
+
+class DamageQueue {
+public:
+    std::vector<DamageEvent> events;
+
+    void Damage(Zombie *target, int amount, bool slow = false) { events.push_back({target, amount, slow, false}); }
+    void Kill(Zombie *target) { events.push_back({target, 0, false, true}); }
+
+    // Adds each queued event to its target's pendingDamage (a kill counts as all its health),
+    // so a later phase of the tick sees what is already on its way. Only call it while no
+    // lane is queueing: a Cherry Bomb queues on its own lane for zombies in the next ones.
+    void MarkPending() const;
+
+    // Applies every event in order, retires the zombies that reached 0 health and empties
+    // the queue. Returns the score earned by the kills.
+    int Commit();
+
+    void Clear() { events.clear(); }
+    size_t Count() const { return events.size(); }
+};
+
+#endif // DAMAGE_EVENTS_H
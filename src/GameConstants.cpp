@@ -0,0 +1,16 @@
+// game_constants.cpp
+#include "GameConstants.h"
+
+// Screen and grid layout shared by the simulation and the renderer.
+// These used to live in main.cpp; they are defined here so the pvz_sim
+// library links on its own without the windowed game.
+const int SCREEN_WIDTH = 1280;
+const int SCREEN_HEIGHT = 720;
+const int GRID_ROWS = STANDARD_BOARD_ROWS;
+const int GRID_COLS = STANDARD_BOARD_COLS;
+const int ORIGINAL_TILE_SIZE = 80;
+const int TILE_SIZE = static_cast<int>(ORIGINAL_TILE_SIZE * 1.2f);
+const int Y_OFFSET = 80;
+const int UI_PANEL_HEIGHT = 120;
+const int GRID_START_X = 90;
+const int GRID_START_Y = UI_PANEL_HEIGHT + Y_OFFSET;
@@ -5,12 +5,30 @@
 // Global Screen and Grid Constants
 extern const int SCREEN_WIDTH;
 extern const int SCREEN_HEIGHT;
+extern const int UI_PANEL_HEIGHT;
+// Layout of the standard 5x9 lawn; a World reads its own from its BoardConfig.
+// The size is also a compile-time constant, for the fixed-size StandardBoard.
+const int STANDARD_BOARD_ROWS = 5;
+const int STANDARD_BOARD_COLS = 9;
 extern const int GRID_ROWS;
 extern const int GRID_COLS;
 extern const int TILE_SIZE;
 extern const int GRID_START_X;
 extern const int GRID_START_Y;
 
+// Fixed simulation timestep
+const float SIM_TICK_RATE = 120.0f; // Simulation ticks per second, independent of the render frame rate
+const int SIM_MAX_STEPS_PER_FRAME = 8; // Catch-up limit after a hitch; any time beyond it is dropped
+
+// Starting projectile store size per lane. A store grows past it when a lane needs more,
+// up to the most peas the board can have in flight (BoardConfig::MaxLaneProjectiles)
+const int PROJECTILE_LANE_CAPACITY = 256;
+const float PEA_MAX_SHOTS_PER_SECOND = 2.0f; // The fastest shooter: a Repeater's two peas per second
+const float PROJECTILE_WIDTH = 20.0f;
+const float PROJECTILE_HEIGHT = 10.0f;
+const float PROJECTILE_SPEED = 300.0f;
+const int PEA_DAMAGE = 50;
+
 // Cherry Bomb specific
 const float FUSE_DURATION = 1.5f;
 
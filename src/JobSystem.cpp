@@ -0,0 +1,192 @@
+// job_system.cpp
+#include "JobSystem.h"
+#include <algorithm>
+#include <cstdio>
+
+// Which JobSystem the current thread works for, and its index there
+static thread_local const JobSystem *currentSystem = nullptr;
+static thread_local int currentWorkerIndex = 0;
+
+JobSystem::JobSystem(int threadCount)
+    : queuedTasks(0), stopping(false), statsStart(std::chrono::steady_clock::now()) {
+    threadCount = std::max(1, threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    currentSystem = this;
+    currentWorkerIndex = 0;
+    for (int i = 1; i < threadCount; ++i) {
+        threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepCondition.notify_all();
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    if (currentSystem == this) {
+        currentSystem = nullptr;
+    }
+}
+
+int JobSystem::CurrentWorker() const {
+    return currentSystem == this ? currentWorkerIndex : 0;
+}
+
+void JobSystem::Run(TaskGroup &group, std::function<void()> task) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    WorkerQueue &queue = *queues[CurrentWorker()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back({std::move(task), &group});
+    }
+
+    // Taking the sleep lock orders this against a worker that is about to go to sleep,
+    // so the wake-up cannot be lost
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks.fetch_add(1, std::memory_order_release);
+    }
+    sleepCondition.notify_one();
+}
+
+bool JobSystem::PopOwn(int worker, Task &task) {
+    WorkerQueue &queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::Steal(int thief, Task &task) {
+    // Start with the next worker along so thieves spread out over the victims
+    int count = ThreadCount();
+    for (int offset = 1; offset < count; ++offset) {
+        WorkerQueue &victim = *queues[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::FindTask(int worker, Task &task) {
+    if (PopOwn(worker, task)) {
+        return true;
+    }
+    if (Steal(worker, task)) {
+        queues[worker]->tasksStolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(int worker, Task &task) {
+    auto start = std::chrono::steady_clock::now();
+    task.fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    WorkerQueue &queue = *queues[worker];
+    queue.tasksRun.fetch_add(1, std::memory_order_relaxed);
+    queue.busyNanoseconds.fetch_add(
+        (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+
+    task.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::Wait(TaskGroup &group) {
+    int worker = CurrentWorker();
+    Task task;
+    while (!group.Done()) {
+        if (FindTask(worker, task)) {
+            Execute(worker, task);
+        } else {
+            // The rest of the group is running on other workers; nothing left to help with
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(int count, const std::function<void(int)> &fn, int grainSize) {
+    if (count <= 0) return;
+    grainSize = std::max(1, grainSize);
+    if (ThreadCount() == 1 || count <= grainSize) {
+        for (int i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    TaskGroup group;
+    for (int begin = 0; begin < count; begin += grainSize) {
+        int end = std::min(begin + grainSize, count);
+        Run(group, [&fn, begin, end] {
+            for (int i = begin; i < end; ++i) fn(i);
+        });
+    }
+    Wait(group);
+}
+
+void JobSystem::WorkerLoop(int worker) {
+    currentSystem = this;
+    currentWorkerIndex = worker;
+
+    Task task;
+    while (true) {
+        if (FindTask(worker, task)) {
+            Execute(worker, task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this] { return stopping || queuedTasks.load(std::memory_order_acquire) > 0; });
+        if (stopping) return;
+    }
+}
+
+std::vector<JobSystem::WorkerStats> JobSystem::Stats() const {
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - statsStart).count();
+
+    std::vector<WorkerStats> stats;
+    for (const auto &queue: queues) {
+        WorkerStats worker;
+        worker.tasksRun = queue->tasksRun.load(std::memory_order_relaxed);
+        worker.tasksStolen = queue->tasksStolen.load(std::memory_order_relaxed);
+        worker.busySeconds = queue->busyNanoseconds.load(std::memory_order_relaxed) * 1e-9;
+        worker.utilization = wallSeconds > 0.0 ? worker.busySeconds / wallSeconds : 0.0;
+        stats.push_back(worker);
+    }
+    return stats;
+}
+
+void JobSystem::ResetStats() {
+    for (auto &queue: queues) {
+        queue->tasksRun = 0;
+        queue->tasksStolen = 0;
+        queue->busyNanoseconds = 0;
+    }
+    statsStart = std::chrono::steady_clock::now();
+}
+
+void JobSystem::PrintStats() const {
+    std::vector<WorkerStats> stats = Stats();
+    std::printf("Job system: %d threads\n", ThreadCount());
+    for (size_t i = 0; i < stats.size(); ++i) {
+        std::printf("  worker %zu%s  tasks %10llu  stolen %10llu  busy %8.3f s  utilization %5.1f%%\n",
+                    i, i == 0 ? " (main)" : "       ",
+                    (unsigned long long) stats[i].tasksRun, (unsigned long long) stats[i].tasksStolen,
+                    stats[i].busySeconds, stats[i].utilization * 100.0);
+    }
+}
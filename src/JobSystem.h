@@ -0,0 +1,111 @@
+// job_system.h
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include <chrono>
+
+//----------------------------------------------------------------------------------
+// Task Group
+//----------------------------------------------------------------------------------
+// Counts the tasks started with JobSystem::Run() that have not finished yet.
+// JobSystem::Wait() returns once the count is back to zero.
+class TaskGroup {
+public:
+    TaskGroup() : pending(0) {}
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    bool Done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending;
+};
+
+//----------------------------------------------------------------------------------
+// Job System
+//----------------------------------------------------------------------------------
+// A small work-stealing scheduler shared by the simulation, asset loading and tools.
+//
+// Every worker has its own deque: it pushes and pops new tasks at the back (newest
+// first, which keeps nested work cache-warm) and, when it runs dry, steals the oldest
+// task from the front of someone else's. The thread that creates the JobSystem counts as
+// worker 0; it does not run tasks on its own, but helps with them whenever it Wait()s,
+// so a JobSystem of N threads starts N - 1 background workers.
+class JobSystem {
+public:
+    // How one worker spent its time since the last ResetStats()
+    struct WorkerStats {
+        uint64_t tasksRun;
+        uint64_t tasksStolen; // Of tasksRun, how many came from another worker's deque
+        double busySeconds;
+        double utilization; // busySeconds over the wall time since ResetStats()
+    };
+
+    explicit JobSystem(int threadCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    // Queues a task on the calling worker's deque (worker 0's if called from a thread
+    // outside the system) and counts it in group
+    void Run(TaskGroup &group, std::function<void()> task);
+
+    // Runs queued tasks (this group's or anyone's) until every task in group has finished
+    void Wait(TaskGroup &group);
+
+    // Runs fn(i) for every i in [0, count), grainSize indices per task, and waits for all of them
+    void ParallelFor(int count, const std::function<void(int)> &fn, int grainSize = 1);
+
+    int ThreadCount() const { return (int) queues.size(); }
+
+    std::vector<WorkerStats> Stats() const;
+    void ResetStats();
+
+    // Prints one line per worker: tasks run, tasks stolen and utilization
+    void PrintStats() const;
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup *group;
+    };
+
+    // One per worker. alignas keeps each worker's lock and counters on their own cache line.
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::atomic<uint64_t> tasksRun{0};
+        std::atomic<uint64_t> tasksStolen{0};
+        std::atomic<uint64_t> busyNanoseconds{0};
+    };
+
+    int CurrentWorker() const;
+    bool PopOwn(int worker, Task &task);
+    bool Steal(int thief, Task &task);
+    bool FindTask(int worker, Task &task);
+    void Execute(int worker, Task &task);
+    void WorkerLoop(int worker);
+
+    std::vector<std::unique_ptr<WorkerQueue> > queues;
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition; // Idle workers wait here for new tasks
+    std::atomic<int> queuedTasks; // Tasks sitting in any deque, so sleepers know when to wake
+    bool stopping;
+
+    std::chrono::steady_clock::time_point statsStart;
+};
+
+#endif // JOB_SYSTEM_H
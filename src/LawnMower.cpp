@@ -1,7 +1,8 @@
 #include "LawnMower.h"
+#include "MathUtils.h"
 
-LawnMower::LawnMower(Rectangle rect, int row, Texture2D texture)
-    : rect(rect), row(row), texture(texture), active(true), activated(false), speed(300.0f) // Adjusted speed
+LawnMower::LawnMower(Rectangle rect, int row, const Sprite &sprite)
+    : rect(rect), prevRect(rect), row(row), sprite(sprite), active(true), activated(false), speed(300.0f) // Adjusted speed
 {
 
 }
@@ -9,12 +10,13 @@ LawnMower::LawnMower(Rectangle rect, int row, Texture2D texture)
 void LawnMower::Update(float deltaTime) {
     if (activated && active) {
         rect.x += speed * deltaTime;
-        // The lawnmower will be deactivated in main.cpp once it goes off-screen
+        // Simulation::UpdateLaneZombies deactivates the lawnmower once it is past the edge of the field
     }
 }
 
-void LawnMower::Draw() {
+void LawnMower::Draw(RenderQueue &queue, float alpha) {
     if (active) {
-        DrawTextureRec(texture, (Rectangle){0, 0, (float)texture.width, (float)texture.height}, {rect.x, rect.y}, WHITE);
+        Rectangle drawRect = LerpRect(prevRect, rect, alpha);
+        queue.Push(RenderLayer::MOWERS, row, sprite, {drawRect.x, drawRect.y, sprite.region.width, sprite.region.height});
     }
 }
\ No newline at end of file
@@ -2,20 +2,23 @@
 #define LAWNMOWER_H
 
 #include "raylib.h"
+#include "Sprite.h"
+#include "RenderQueue.h"
 
 class LawnMower {
 public:
     Rectangle rect;
+    Rectangle prevRect; // rect at the start of the current simulation tick, for render interpolation
     int row;
-    Texture2D texture;
+    Sprite sprite;
     bool active;     // If true, it's currently on screen and potentially moving
     bool activated;  // If true, it has been triggered and is moving across the lane
 
     float speed;     // Speed at which the lawnmower moves
 
-    LawnMower(Rectangle rect, int row, Texture2D texture);
+    LawnMower(Rectangle rect, int row, const Sprite &sprite);
     void Update(float deltaTime);
-    void Draw();
+    void Draw(RenderQueue &queue, float alpha = 1.0f);
 };
 
 #endif // LAWNMOWER_H
\ No newline at end of file
@@ -0,0 +1,23 @@
+// math_utils.h
+#ifndef MATH_UTILS_H
+#define MATH_UTILS_H
+
+#include "raylib.h"
+
+// Linear blend between two values; alpha = 0 gives from, alpha = 1 gives to.
+inline float LerpFloat(float from, float to, float alpha) {
+    return from + (to - from) * alpha;
+}
+
+// Linear blend between the rectangle of the previous simulation tick and the current one.
+// alpha = 0 gives the previous tick, alpha = 1 the current one.
+inline Rectangle LerpRect(Rectangle from, Rectangle to, float alpha) {
+    return (Rectangle){
+        from.x + (to.x - from.x) * alpha,
+        from.y + (to.y - from.y) * alpha,
+        from.width + (to.width - from.width) * alpha,
+        from.height + (to.height - from.height) * alpha
+    };
+}
+
+#endif // MATH_UTILS_H
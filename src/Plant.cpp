@@ -1,302 +1,188 @@
 // plant.cpp
 #include "Plant.h"
-#include "Projectile.h" // Needed to create Projectile objects
+#include "Projectile.h" // Needed to spawn projectiles
 #include "Zombie.h"     // Needed to interact with Zombie objects
-#include <iostream>     // For debug prints (optional)
-#include <algorithm>    // For std::max (CherryBomb)
+#include "World.h"      // Lane buckets
 
 // Defined global grid constants from main.cpp
 // These need to be extern if they are defined in main.cpp and used here.
-extern const int GRID_START_X;
-extern const int GRID_START_Y;
-extern const int TILE_SIZE;
-extern const int GRID_ROWS;
-extern const int GRID_COLS;
 
 //----------------------------------------------------------------------------------
 // Base Plant Implementation
 //----------------------------------------------------------------------------------
-Plant::Plant(Rectangle rect, int health, Color color, Texture2D tex, int row, int col, int numFrames, float frameSpeed)
-    : rect(rect), health(health), active(true), color(color), texture(tex),
-      row(row), col(col),
-      currentFrame(0), frameTimer(0.0f), frameSpeed(frameSpeed), numFrames(numFrames) {
-    sourceRect = {0, 0, (float) texture.width / numFrames, (float) texture.height};
+Plant::Plant(Rectangle rect, int health, Color color, const AnimationSet &animations, int row, int col)
+    : rect(rect), health(health), active(true), color(color), animations(&animations), animation(),
+      row(row), col(col) {
 }
 
-void Plant::Draw() const {
+void Plant::Draw(RenderQueue &queue) const {
     if (active) {
-        DrawTexturePro(texture, sourceRect, rect, {0, 0}, 0, WHITE);
+        queue.Push(RenderLayer::PLANTS, row, animations->texture, animation.FrameRect(*animations), rect);
     }
 }
 
 //----------------------------------------------------------------------------------
 // Peashooter Implementations
 //----------------------------------------------------------------------------------
-Peashooter::Peashooter(Rectangle rect, int row, int col, Texture2D tex)
-    : Plant(rect, 100, GREEN, tex, row, col, 1, 0.0f),
+Peashooter::Peashooter(Rectangle rect, int row, int col, const AnimationSet &animations)
+    : Plant(rect, 100, GREEN, animations, row, col),
       fireRate(1.5f), fireTimer(1.5f) {
 }
 
-void Peashooter::Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                        std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                        Texture2D peaTex) {
+void Peashooter::Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) {
     if (!active) return;
 
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
+    animation.Advance(*animations, deltaTime);
 
     fireTimer += deltaTime;
     if (fireTimer >= fireRate) {
-        bool zombieInLane = false;
-        for (const auto &zombie: zombies) {
-            if (zombie->active && zombie->row == this->row && zombie->rect.x > this->rect.x) {
-                zombieInLane = true;
-                break;
-            }
-        }
-
-        if (zombieInLane) {
+        // A shot dropped by a full lane store leaves the timer primed, so it is retried next tick
+        if (world.HasZombieAhead(row, this->rect.x) &&
+            world.SpawnProjectile(row, this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4,
+                                  PROJECTILE_SPEED, PEA_DAMAGE, ProjectileType::NORMAL)) {
             fireTimer = 0.0f;
-            std::unique_ptr<Projectile> newProjectile = std::make_unique<Projectile>(
-                (Rectangle){this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, 20, 10},
-                (Vector2){300.0f, 0.0f},
-                50,
-                peaTex,
-                ProjectileType::NORMAL
-            );
-            projectiles.push_back(std::move(newProjectile));
-            PlaySound(shootSound);
+            world.QueueSound(row, shootSound);
         }
     }
 }
 
-void Peashooter::Draw() const {
-    Plant::Draw();
+void Peashooter::Draw(RenderQueue &queue) const {
+    Plant::Draw(queue);
 }
 
 //----------------------------------------------------------------------------------
 // Sunflower Implementations
 //----------------------------------------------------------------------------------
-Sunflower::Sunflower(Rectangle rect, int row, int col, Texture2D tex)
-    : Plant(rect, 80, YELLOW, tex, row, col, 1, 0.0f),
+Sunflower::Sunflower(Rectangle rect, int row, int col, const AnimationSet &animations)
+    : Plant(rect, 80, YELLOW, animations, row, col),
       sunProductionInterval(10.0f), sunProductionTimer(0.0f) {
 }
 
-void Sunflower::Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                       std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                       Texture2D peaTex) {
+void Sunflower::Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) {
     if (!active) return;
 
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
+    animation.Advance(*animations, deltaTime);
 
     sunProductionTimer += deltaTime;
     if (sunProductionTimer >= sunProductionInterval) {
         sunProductionTimer = 0.0f;
         sunCurrency += 25;
-        std::cout << "Sunflower produced sun! Current sun: " << sunCurrency << std::endl;
     }
 }
 
-void Sunflower::Draw() const {
-    Plant::Draw();
+void Sunflower::Draw(RenderQueue &queue) const {
+    Plant::Draw(queue);
 }
 
 //----------------------------------------------------------------------------------
 // CherryBomb Implementations
 //----------------------------------------------------------------------------------
-CherryBomb::CherryBomb(Rectangle rect, int row, int col, Texture2D tex, Sound expSound)
-    : Plant(rect, 1, RED, tex, row, col, 1, 0.0f),
+CherryBomb::CherryBomb(Rectangle rect, int row, int col, const AnimationSet &animations, Sound expSound)
+    : Plant(rect, 1, RED, animations, row, col),
       fuseTimer(0.0f), exploded(false), explosionSound(expSound) {
 }
 
-void CherryBomb::Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                        std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                        Texture2D peaTex) {
+void CherryBomb::Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) {
     if (!active || exploded) return;
 
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
+    animation.Advance(*animations, deltaTime);
 
     fuseTimer += deltaTime;
     if (fuseTimer >= FUSE_DURATION) {
         exploded = true;
         this->active = false;
-        PlaySound(explosionSound);
+        world.QueueSound(this->row, explosionSound);
 
+        // Every zombie in the 3x3 tiles around the bomb: its own lane and the ones either side
         int explosionDamage = 9999;
-        Rectangle explosionArea = {
-            (float) (GRID_START_X + (this->col - 1) * TILE_SIZE),
-            (float) (GRID_START_Y + (this->row - 1) * TILE_SIZE),
-            (float) (TILE_SIZE * 3),
-            (float) (TILE_SIZE * 3)
-        };
-
-        explosionArea.x = std::max((float) GRID_START_X, explosionArea.x);
-        explosionArea.y = std::max((float) GRID_START_Y, explosionArea.y);
-        explosionArea.width = std::min((float) GRID_COLS * TILE_SIZE - (explosionArea.x - GRID_START_X),
-                                       explosionArea.width);
-        explosionArea.height = std::min((float) GRID_ROWS * TILE_SIZE - (explosionArea.y - GRID_START_Y),
-                                        explosionArea.height);
-
-        for (auto &zombie: zombies) {
-            if (zombie->active && CheckCollisionRecs(explosionArea, zombie->rect)) {
-                zombie->health -= explosionDamage;
-            }
-        }
-        std::cout << "CherryBomb exploded! Damaged zombies in area." << std::endl;
+        // Recorded on this lane's queue even for zombies in the neighbouring lanes, so the
+        // bomb never writes to another lane while lanes are being stepped
+        world.ForEachZombieAroundTile(this->row, this->col, 1, 1, [this, &world, explosionDamage](Zombie &zombie) {
+            world.QueueDamage(this->row, &zombie, explosionDamage);
+        });
     }
 }
 
-void CherryBomb::Draw() const {
-    Plant::Draw();
+void CherryBomb::Draw(RenderQueue &queue) const {
+    Plant::Draw(queue);
 }
 
 //----------------------------------------------------------------------------------
 // WallNut Implementations
 //----------------------------------------------------------------------------------
-WallNut::WallNut(Rectangle rect, int row, int col, Texture2D tex)
-    : Plant(rect, 400, BROWN, tex, row, col, 1, 0.0f) {
+WallNut::WallNut(Rectangle rect, int row, int col, const AnimationSet &animations)
+    : Plant(rect, 400, BROWN, animations, row, col) {
 }
 
-void WallNut::Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                     std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                     Texture2D peaTex) {
+void WallNut::Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) {
     if (!active) return;
 
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
+    animation.Advance(*animations, deltaTime);
 }
 
-void WallNut::Draw() const {
-    Plant::Draw();
+void WallNut::Draw(RenderQueue &queue) const {
+    Plant::Draw(queue);
 }
 
 //----------------------------------------------------------------------------------
 // Repeater Implementations (NEW!)
 //----------------------------------------------------------------------------------
-Repeater::Repeater(Rectangle rect, int row, int col, Texture2D tex)
-    : Peashooter(rect, row, col, tex) {
+Repeater::Repeater(Rectangle rect, int row, int col, const AnimationSet &animations)
+    : Peashooter(rect, row, col, animations) {
     this->fireRate = 1.0f;
     this->fireTimer = this->fireRate;
     this->health = 100;
 }
 
-void Repeater::Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                      std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                      Texture2D peaTex) {
+void Repeater::Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) {
     if (!active) return;
 
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
+    animation.Advance(*animations, deltaTime);
 
     fireTimer += deltaTime;
     if (fireTimer >= fireRate) {
-        bool zombieInLane = false;
-        for (const auto &zombie: zombies) {
-            if (zombie->active && zombie->row == this->row && zombie->rect.x > this->rect.x) {
-                zombieInLane = true;
-                break;
-            }
-        }
-
-        if (zombieInLane) {
+        if (world.HasZombieAhead(row, this->rect.x) &&
+            world.SpawnProjectile(row, this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4,
+                                  PROJECTILE_SPEED, PEA_DAMAGE, ProjectileType::NORMAL)) {
             fireTimer = 0.0f;
+            world.QueueSound(row, shootSound);
 
-            std::unique_ptr<Projectile> newProjectile1 = std::make_unique<Projectile>(
-                (Rectangle){this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, 20, 10},
-                (Vector2){300.0f, 0.0f},
-                50,
-                peaTex,
-                ProjectileType::NORMAL
-            );
-            projectiles.push_back(std::move(newProjectile1));
-            PlaySound(shootSound);
-
-            std::unique_ptr<Projectile> newProjectile2 = std::make_unique<Projectile>(
-                (Rectangle){this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, 20, 10},
-                (Vector2){300.0f, 0.0f},
-                50,
-                peaTex,
-                ProjectileType::NORMAL
-            );
-            projectiles.push_back(std::move(newProjectile2));
+            world.SpawnProjectile(row, this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4,
+                                  PROJECTILE_SPEED, PEA_DAMAGE, ProjectileType::NORMAL);
         }
     }
 }
 
-void Repeater::Draw() const {
-    Plant::Draw();
+void Repeater::Draw(RenderQueue &queue) const {
+    Plant::Draw(queue);
 }
 
 //----------------------------------------------------------------------------------
 // IcePea Implementations (NEW!)
 //----------------------------------------------------------------------------------
-IcePea::IcePea(Rectangle rect, int row, int col, Texture2D tex, Texture2D icePeaProjTex)
-    : Peashooter(rect, row, col, tex), icePeaProjectileTex(icePeaProjTex) {
+IcePea::IcePea(Rectangle rect, int row, int col, const AnimationSet &animations)
+    : Peashooter(rect, row, col, animations) {
     this->fireRate = 1.8f;
     this->fireTimer = this->fireRate;
     this->health = 200;
 }
 
-void IcePea::Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                    std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                    Texture2D peaTex) {
+void IcePea::Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) {
     if (!active) return;
 
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
+    animation.Advance(*animations, deltaTime);
 
     fireTimer += deltaTime;
     if (fireTimer >= fireRate) {
-        bool zombieInLane = false;
-        for (const auto &zombie: zombies) {
-            if (zombie->active && zombie->row == this->row && zombie->rect.x > this->rect.x) {
-                zombieInLane = true;
-                break;
-            }
-        }
-
-        if (zombieInLane) {
+        if (world.HasZombieAhead(row, this->rect.x) &&
+            world.SpawnProjectile(row, this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4,
+                                  PROJECTILE_SPEED, PEA_DAMAGE, ProjectileType::FROZEN)) {
             fireTimer = 0.0f;
-
-            std::unique_ptr<Projectile> newProjectile = std::make_unique<Projectile>(
-                (Rectangle){this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, 20, 10},
-                (Vector2){300.0f, 0.0f},
-                50,
-                icePeaProjectileTex,
-                ProjectileType::FROZEN
-            );
-            projectiles.push_back(std::move(newProjectile));
-            PlaySound(shootSound);
+            world.QueueSound(row, shootSound);
         }
     }
 }
 
-void IcePea::Draw() const {
-    Plant::Draw();
+void IcePea::Draw(RenderQueue &queue) const {
+    Plant::Draw(queue);
 }
@@ -4,10 +4,13 @@
 #include "raylib.h"
 #include <vector>
 #include <memory>
+#include "Sprite.h"
+#include "RenderQueue.h"
+#include "Animation.h"
 
 // Forward declarations to avoid circular dependencies
 class Zombie;
-class Projectile;
+class World;
 
 // Enum to identify different plant types
 enum class PlantType {
@@ -30,26 +33,21 @@ public:
     int health;
     bool active;
     Color color; // For debugging colors
-    Texture2D texture; // The sprite/texture for the plant
-    Rectangle sourceRect; // Current frame in the sprite sheet
+    const AnimationSet *animations; // Frame tables for this plant type, owned by the Simulation
+    AnimationState animation;
 
     int row;
     int col;
 
-    int currentFrame;
-    float frameTimer;
-    float frameSpeed;
-    int numFrames;
-
-    Plant(Rectangle rect, int health, Color color, Texture2D tex, int row, int col, int numFrames, float frameSpeed);
+    Plant(Rectangle rect, int health, Color color, const AnimationSet &animations, int row, int col);
 
     virtual ~Plant() = default; // Virtual destructor for proper cleanup of derived objects
 
-    virtual void Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                        std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                        Texture2D peaTex) = 0;
+    // sunCurrency is the sun earned by this plant's lane during the tick; the Simulation
+    // adds every lane's total to the bank afterwards
+    virtual void Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) = 0;
 
-    virtual void Draw() const;
+    virtual void Draw(RenderQueue &queue) const;
 
     virtual int GetCost() const = 0;
 
@@ -74,100 +72,85 @@ protected:
     float fireTimer;
 
 public:
-    Peashooter(Rectangle rect, int row, int col, Texture2D tex);
+    Peashooter(Rectangle rect, int row, int col, const AnimationSet &animations);
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                Texture2D peaTex) override;
+    void Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) override;
 
-    void Draw() const override;
+    void Draw(RenderQueue &queue) const override;
 
     int GetCost() const override { return 50; }
     PlantType GetType() const override { return PlantType::PEASHOOTER; }
 };
 
 // Sunflower
-class Sunflower : public Plant {
+class Sunflower final : public Plant {
 private:
     float sunProductionInterval; // Time between sun production
     float sunProductionTimer; // Timer to track sun production
 
 public:
-    Sunflower(Rectangle rect, int row, int col, Texture2D tex);
+    Sunflower(Rectangle rect, int row, int col, const AnimationSet &animations);
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                Texture2D peaTex) override;
+    void Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) override;
 
-    void Draw() const override;
+    void Draw(RenderQueue &queue) const override;
 
     int GetCost() const override { return 25; }
     PlantType GetType() const override { return PlantType::SUNFLOWER; }
 };
 
 // CherryBomb
-class CherryBomb : public Plant {
+class CherryBomb final : public Plant {
 private:
     float fuseTimer; // Time until explosion
     bool exploded;
     Sound explosionSound;
 
 public:
-    CherryBomb(Rectangle rect, int row, int col, Texture2D tex, Sound expSound);
+    CherryBomb(Rectangle rect, int row, int col, const AnimationSet &animations, Sound expSound);
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                Texture2D peaTex) override;
+    void Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) override;
 
-    void Draw() const override;
+    void Draw(RenderQueue &queue) const override;
 
     int GetCost() const override { return 50; }
     PlantType GetType() const override { return PlantType::CHERRY_BOMB; }
 };
 
 // WallNut
-class WallNut : public Plant {
+class WallNut final : public Plant {
 public:
-    WallNut(Rectangle rect, int row, int col, Texture2D tex);
+    WallNut(Rectangle rect, int row, int col, const AnimationSet &animations);
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                Texture2D peaTex) override;
+    void Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) override;
 
-    void Draw() const override;
+    void Draw(RenderQueue &queue) const override;
 
     int GetCost() const override { return 75; }
     PlantType GetType() const override { return PlantType::WALNUT; }
 };
 
 // Repeater
-class Repeater : public Peashooter {
+class Repeater final : public Peashooter {
 public:
-    Repeater(Rectangle rect, int row, int col, Texture2D tex);
+    Repeater(Rectangle rect, int row, int col, const AnimationSet &animations);
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                Texture2D peaTex) override;
+    void Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) override;
 
-    void Draw() const override;
+    void Draw(RenderQueue &queue) const override;
 
     int GetCost() const override { return 200; }
     PlantType GetType() const override { return PlantType::REPEATER; }
 };
 
 // IcePea
-class IcePea : public Peashooter {
-private:
-    Texture2D icePeaProjectileTex;
-
+class IcePea final : public Peashooter {
 public:
-    IcePea(Rectangle rect, int row, int col, Texture2D tex, Texture2D icePeaProjTex);
+    IcePea(Rectangle rect, int row, int col, const AnimationSet &animations);
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies,
-                std::vector<std::unique_ptr<Projectile> > &projectiles, int &sunCurrency, Sound shootSound,
-                Texture2D peaTex) override;
+    void Update(float deltaTime, World &world, int &sunCurrency, Sound shootSound) override;
 
-    void Draw() const override;
+    void Draw(RenderQueue &queue) const override;
 
     int GetCost() const override { return 150; }
     PlantType GetType() const override { return PlantType::ICE_PEA; }
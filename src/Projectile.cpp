@@ -1,39 +1,121 @@
 // Projectile.cpp
 #include "Projectile.h"
-#include "Zombie.h" // For interacting with zombies
-
-void Projectile::Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies) {
-    if (!active) return;
-
-    // Move the projectile
-    rect.x += speed.x * deltaTime;
-    rect.y += speed.y * deltaTime;
-
-    // Check for collision with zombies
-    for (auto& zombie : zombies) {
-        if (zombie->active && CheckCollisionRecs(rect, zombie->rect)) {
-            zombie->TakeDamage(damage); // Apply damage to the zombie
-            if (type == ProjectileType::FROZEN) {
-                zombie->ApplySlowEffect(); // Apply slow effect if frozen type
-            }
-            active = false; // Deactivate projectile after impact
-            break; // Exit collision check
+#include "Zombie.h" // For reading zombie rectangles
+#include "GameConstants.h"
+#include <algorithm>
+
+//----------------------------------------------------------------------------------
+// ZombieHitboxes Implementation
+//----------------------------------------------------------------------------------
+void ZombieHitboxes::Build(const std::vector<Zombie *> &laneZombies) {
+    left.clear();
+    right.clear();
+    top.clear();
+    bottom.clear();
+    health.clear();
+    zombies.clear();
+    maxWidth = 0.0f;
+
+    for (Zombie *zombie: laneZombies) {
+        if (!zombie->active) continue;
+        zombies.push_back(zombie);
+        left.push_back(zombie->rect.x);
+        right.push_back(std::max(zombie->rect.x, zombie->prevRect.x) + zombie->rect.width);
+        top.push_back(zombie->rect.y);
+        bottom.push_back(zombie->rect.y + zombie->rect.height);
+        health.push_back(zombie->health - zombie->pendingDamage); // Net of blasts queued earlier this tick
+        maxWidth = std::max(maxWidth, right.back() - left.back());
+    }
+}
+
+int ZombieHitboxes::FirstOverlap(float x, float y, float width, float height) const {
+    // No zombie starting further left than x - maxWidth can reach x
+    size_t i = std::lower_bound(left.begin(), left.end(), x - maxWidth) - left.begin();
+    for (; i < left.size() && left[i] < x + width; ++i) {
+        if (right[i] > x && top[i] < y + height && bottom[i] > y && health[i] > 0) {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+//----------------------------------------------------------------------------------
+// ProjectileStore Implementation
+//----------------------------------------------------------------------------------
+ProjectileStore::ProjectileStore(size_t limit)
+    : limit(limit), count(0), peakCount(0), totalSpawned(0), droppedCount(0) {
+    Grow(std::min(limit, (size_t) PROJECTILE_LANE_CAPACITY));
+}
+
+void ProjectileStore::Grow(size_t capacity) {
+    x.resize(capacity);
+    y.resize(capacity);
+    prevX.resize(capacity);
+    vx.resize(capacity);
+    damage.resize(capacity);
+    type.resize(capacity);
+    alive.resize(capacity);
+}
+
+bool ProjectileStore::Spawn(float px, float py, float pvx, int pDamage, ProjectileType pType) {
+    if (count == Capacity()) {
+        if (Capacity() >= limit) {
+            droppedCount++;
+            return false;
         }
+        Grow(std::min(limit, std::max((size_t) 1, Capacity() * 2)));
     }
 
-    // Deactivate if it goes off-screen
-    if (rect.x > GetScreenWidth() || rect.y > GetScreenHeight() || rect.x < 0 || rect.y < 0) {
-        active = false;
+    x[count] = px;
+    y[count] = py;
+    prevX[count] = px;
+    vx[count] = pvx;
+    damage[count] = pDamage;
+    type[count] = pType;
+    alive[count] = 1;
+    count++;
+
+    totalSpawned++;
+    if (count > peakCount) peakCount = count;
+    return true;
+}
+
+void ProjectileStore::Move(float deltaTime) {
+    float *__restrict px = x.data();
+    float *__restrict pPrevX = prevX.data();
+    const float *__restrict pvx = vx.data();
+    for (size_t i = 0; i < count; ++i) {
+        pPrevX[i] = px[i];
+        px[i] += pvx[i] * deltaTime;
     }
 }
 
-void Projectile::Draw() const {
-    if (!active) return;
+void ProjectileStore::CullBeyond(float maxX) {
+    const float *__restrict px = x.data();
+    unsigned char *__restrict pAlive = alive.data();
+    for (size_t i = 0; i < count; ++i) {
+        pAlive[i] &= (unsigned char) (px[i] <= maxX);
+    }
+}
 
-    // Draw the projectile. If there is a texture, use it; otherwise, fall back to color
-    if (texture.id > 0) { // Assuming a valid texture has id > 0
-        DrawTexturePro(texture, sourceRect, rect, {0, 0}, 0.0f, WHITE);
-    } else {
-        DrawRectangleRec(rect, color);
+void ProjectileStore::Compact() {
+    size_t i = 0;
+    while (i < count) {
+        if (alive[i]) {
+            ++i;
+            continue;
+        }
+        size_t last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        prevX[i] = prevX[last];
+        vx[i] = vx[last];
+        damage[i] = damage[last];
+        type[i] = type[last];
+        alive[i] = alive[last];
     }
-}
\ No newline at end of file
+}
+
+void ProjectileStore::Clear() {
+    count = 0;
+}
@@ -2,11 +2,11 @@
 #ifndef PROJECTILE_H
 #define PROJECTILE_H
 
-#include "raylib.h" // Needed for Rectangle, Vector2, Color, Texture2D
-#include <vector>   // Needed for Projectile::Update interaction with zombies
-#include <memory>   // Needed for std::unique_ptr
+#include "raylib.h" // Needed for Rectangle
+#include <vector>
+#include <cstddef>
 
-// Forward declaration for Zombie, as Projectile might interact with it
+// Forward declaration for Zombie, as projectiles are tested against them
 class Zombie;
 
 // Projectile types
@@ -16,40 +16,84 @@ enum class ProjectileType {
 };
 
 //----------------------------------------------------------------------------------
-// Projectile Class
+// Zombie Hitboxes
 //----------------------------------------------------------------------------------
+// One lane's zombie rectangles as flat arrays sorted by left edge. Rebuilt once per
+// tick so the projectile hit test is a binary search plus a short scan.
+// Build() expects the lane's list to be sorted by x already (see Lane::zombies).
+//
+// Each box spans everything the zombie covered during the tick: zombies walk left, so
+// right comes from where it started (prevRect) and left from where it ended up.
+struct ZombieHitboxes {
+    std::vector<float> left;
+    std::vector<float> right;
+    std::vector<float> top;
+    std::vector<float> bottom;
+    std::vector<int> health; // Health left once everything queued this tick (blasts, then peas) lands
+    std::vector<Zombie *> zombies;
+    float maxWidth = 0.0f; // Widest box in the lane; bounds how far left the scan has to start
 
-class Projectile {
-public:
-    Rectangle rect;
-    Vector2 speed;
-    bool active;
-    Color color;
-    Texture2D texture;
-    Rectangle sourceRect;
-    int currentFrame;
-    float frameTimer;
-    float frameSpeed;
-    int numFrames;
-    int damage;
-    ProjectileType type;
-
-    // Constructor to initialize projectile properties
-    Projectile(Rectangle pRect, Vector2 pSpeed, int pDamage, Texture2D pTex,
-               ProjectileType pType = ProjectileType::NORMAL)
-        : rect(pRect), speed(pSpeed), active(true), damage(pDamage), texture(pTex), type(pType),
-          currentFrame(0), frameTimer(0.0f), frameSpeed(0.1f), numFrames(1) {
-        sourceRect = {0, 0, (float) texture.width / numFrames, (float) texture.height};
-        if (type == ProjectileType::FROZEN) {
-            color = BLUE;
-        } else {
-            color = LIME;
-        }
+    void Build(const std::vector<Zombie *> &laneZombies);
+
+    // Index of the leftmost zombie with health left that overlaps the given box, or -1
+    int FirstOverlap(float x, float y, float width, float height) const;
+
+    // Swept test for a box moving right from fromX to toX this tick: the first zombie it
+    // touched anywhere along the way, so a fast pea or a long tick cannot tunnel through
+    int FirstSweptOverlap(float fromX, float toX, float y, float width, float height) const {
+        return FirstOverlap(fromX, y, toX - fromX + width, height);
     }
+};
+
+//----------------------------------------------------------------------------------
+// Projectile Store
+//----------------------------------------------------------------------------------
+// One lane's projectiles as parallel arrays (structure of arrays). Movement is
+// one straight loop over x/vx that the compiler can vectorize, and hit tests only read
+// the handful of fields they need. The arrays start at PROJECTILE_LANE_CAPACITY (or limit,
+// if smaller) and double when full, never shrinking, so steady-state play does not
+// allocate. A shot beyond limit is dropped and counted.
+class ProjectileStore {
+public:
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> prevX; // x at the start of the current tick, for render interpolation
+    std::vector<float> vx;
+    std::vector<int> damage;
+    std::vector<ProjectileType> type;
+    std::vector<unsigned char> alive;
+
+    explicit ProjectileStore(size_t limit);
+
+    // Returns false (and counts a drop) if the store is full and already at its limit
+    bool Spawn(float px, float py, float pvx, int pDamage, ProjectileType pType);
+
+    // Advances every projectile by vx * deltaTime
+    void Move(float deltaTime);
+
+    // Marks projectiles whose left edge is past maxX as dead
+    void CullBeyond(float maxX);
+
+    // Swap-removes dead projectiles so the live ones stay packed at the front
+    void Compact();
+
+    void Clear();
+
+    size_t Count() const { return count; }
+    size_t Capacity() const { return x.size(); }
+    size_t Limit() const { return limit; }
+    size_t PeakCount() const { return peakCount; }
+    size_t TotalSpawned() const { return totalSpawned; }
+    size_t DroppedCount() const { return droppedCount; }
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie> > &zombies);
+private:
+    void Grow(size_t capacity);
 
-    void Draw() const;
+    size_t limit;
+    size_t count;
+    size_t peakCount;
+    size_t totalSpawned;
+    size_t droppedCount;
 };
 
 #endif // PROJECTILE_H
@@ -0,0 +1,36 @@
+// projectile_collision.cpp
+#include "ProjectileCollision.h"
+#include "World.h"
+#include "GameConstants.h" // PROJECTILE_WIDTH/HEIGHT
+#include <algorithm>
+
+ProjectileCollisionResult RunProjectileCollisionStage(Lane &lane, float deltaTime, float fieldRight) {
+    ProjectileCollisionResult result;
+
+    ZombieHitboxes &hitboxes = lane.hitboxes;
+    hitboxes.Build(lane.zombies);
+
+    ProjectileStore &projectiles = lane.projectiles;
+    projectiles.Move(deltaTime);
+
+    for (size_t i = 0; i < projectiles.Count(); ++i) {
+        if (!projectiles.alive[i]) continue;
+
+        // Sweep from where the pea started the tick to where it ended, stopping at the edge
+        // of play: a pea is culled there, so it must not hit anything beyond it on the way out
+        float fromX = projectiles.prevX[i];
+        if (fromX > fieldRight) continue;
+        float toX = std::min(projectiles.x[i], fieldRight);
+
+        int hit = hitboxes.FirstSweptOverlap(fromX, toX, projectiles.y[i], PROJECTILE_WIDTH, PROJECTILE_HEIGHT);
+        if (hit < 0) continue;
+
+        lane.damage.Damage(hitboxes.zombies[hit], projectiles.damage[i], projectiles.type[i] == ProjectileType::FROZEN);
+        hitboxes.health[hit] -= projectiles.damage[i];
+        projectiles.alive[i] = 0;
+        result.hits++;
+    }
+
+    projectiles.CullBeyond(fieldRight);
+    return result;
+}
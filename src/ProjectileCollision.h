@@ -0,0 +1,29 @@
+// projectile_collision.h
+#ifndef PROJECTILE_COLLISION_H
+#define PROJECTILE_COLLISION_H
+
+struct Lane;
+
+//----------------------------------------------------------------------------------
+// Projectile Collision Stage
+//----------------------------------------------------------------------------------
+// The one place projectiles move and hit things. Peas never leave their lane, so the
+// broad phase is simply running the stage once per lane. Every tick it:
+//   1. rebuilds the lane's sorted zombie hitboxes,
+//   2. moves every projectile,
+//   3. finds the first zombie each pea touched along its path this tick (narrow phase,
+//      swept so hits survive low tick rates and big steps),
+//   4. queues the damage and Ice Pea slow on lane.damage (applied by its Commit()),
+//   5. culls the peas that passed fieldRight (the right edge of play).
+// Pending damage is tracked on the hitboxes, starting from what the plant phase already
+// queued (Zombie::pendingDamage), so once a zombie has taken enough hits or blasts to die
+// this tick the peas behind it fly on to the next zombie.
+// Both the windowed game and headless runs reach it through Simulation::Step(). It only
+// touches the one lane, so different lanes can run it on different threads.
+struct ProjectileCollisionResult {
+    int hits = 0; // Projectiles that struck a zombie this tick
+};
+
+ProjectileCollisionResult RunProjectileCollisionStage(Lane &lane, float deltaTime, float fieldRight);
+
+#endif // PROJECTILE_COLLISION_H
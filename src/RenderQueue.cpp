@@ -0,0 +1,66 @@
+// render_queue.cpp
+#include "RenderQueue.h"
+#include "rlgl.h"
+#include <algorithm>
+
+// Sprites written per rlCheckRenderBatchLimit() call. Small enough to fit any rlgl batch
+// buffer (8192 quads on desktop, 2048 on GLES2), so a flush can only happen between chunks.
+static const int QUADS_PER_CHUNK = 1024;
+
+void RenderQueue::Flush() {
+    if (commands.empty()) return;
+
+    std::stable_sort(commands.begin(), commands.end(),
+                     [](const SpriteCommand &a, const SpriteCommand &b) { return a.sortKey < b.sortKey; });
+
+    unsigned int boundTexture = 0;
+    size_t i = 0;
+    while (i < commands.size()) {
+        const Texture2D &texture = commands[i].texture;
+        size_t chunkEnd = i + 1;
+        while (chunkEnd < commands.size() && chunkEnd - i < (size_t) QUADS_PER_CHUNK &&
+               commands[chunkEnd].texture.id == texture.id) {
+            ++chunkEnd;
+        }
+
+        // Draws the batch first if this chunk would not fit in what is left of it
+        bool flushed = rlCheckRenderBatchLimit((int) (chunkEnd - i) * 4);
+        if (flushed) stats.batchFlushes++;
+        if (flushed || texture.id != boundTexture) stats.drawCalls++;
+        boundTexture = texture.id;
+
+        float width = (float) std::max(texture.width, 1);
+        float height = (float) std::max(texture.height, 1);
+
+        rlSetTexture(texture.id);
+        rlBegin(RL_QUADS);
+        for (; i < chunkEnd; ++i) {
+            const SpriteCommand &command = commands[i];
+            const Rectangle &source = command.source;
+            const Rectangle &dest = command.dest;
+
+            float u0 = source.x / width;
+            float v0 = source.y / height;
+            float u1 = (source.x + source.width) / width;
+            float v1 = (source.y + source.height) / height;
+
+            rlColor4ub(command.tint.r, command.tint.g, command.tint.b, command.tint.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            rlTexCoord2f(u0, v0);
+            rlVertex2f(dest.x, dest.y);
+            rlTexCoord2f(u0, v1);
+            rlVertex2f(dest.x, dest.y + dest.height);
+            rlTexCoord2f(u1, v1);
+            rlVertex2f(dest.x + dest.width, dest.y + dest.height);
+            rlTexCoord2f(u1, v0);
+            rlVertex2f(dest.x + dest.width, dest.y);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+
+    rlDrawRenderBatchActive();
+    stats.batchFlushes++;
+    stats.sprites += (int) commands.size();
+    commands.clear();
+}
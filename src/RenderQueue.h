@@ -0,0 +1,77 @@
+// render_queue.h
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include "raylib.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "Sprite.h"
+
+// Draw order of the world sprites; higher layers are drawn on top
+enum class RenderLayer : uint8_t {
+    PLANTS,
+    ZOMBIES,
+    PROJECTILES,
+    MOWERS
+};
+
+// One queued textured quad
+struct SpriteCommand {
+    uint64_t sortKey; // Layer, then depth, then texture id (see RenderQueue::Push)
+    Texture2D texture;
+    Rectangle source; // In texture pixels
+    Rectangle dest;
+    Color tint;
+};
+
+// What the queue sent to the GPU since the last ResetStats()
+struct RenderStats {
+    int sprites = 0;
+    int drawCalls = 0; // rlgl draw entries: one per run of sprites sharing a texture, plus one after every flush
+    int batchFlushes = 0; // Times the rlgl vertex batch was submitted to the GPU
+};
+
+//----------------------------------------------------------------------------------
+// Render Queue
+//----------------------------------------------------------------------------------
+// Collects the world's sprite draws for a frame and submits them in one go. Flush()
+// stable-sorts the commands by layer, then depth (the row, so lower lanes overlap the
+// ones above them), then texture, and writes each run of same-texture sprites straight
+// into rlgl's vertex batch as one draw. Compared with a DrawTexturePro() per entity this
+// skips the per-sprite texture bind/unbind, and sprites that share a texture (all of
+// them, with the atlas) go out in as few GPU draw calls as the batch size allows.
+//
+// Push() only records, and is inline so the entities' Draw() functions in the headless
+// simulation library need none of the render code; Flush() lives in pvz_render.
+class RenderQueue {
+public:
+    void Push(RenderLayer layer, int depth, Texture2D texture, Rectangle source, Rectangle dest, Color tint = WHITE) {
+        if (texture.id == 0) return; // Never loaded; DrawTexturePro() skips these as well
+
+        uint64_t depthBits = (uint64_t) std::clamp(depth, 0, 0xFFFFFF);
+        uint64_t key = ((uint64_t) layer << 56) | (depthBits << 32) | texture.id;
+        commands.push_back({key, texture, source, dest, tint});
+    }
+
+    void Push(RenderLayer layer, int depth, const Sprite &sprite, Rectangle dest, Color tint = WHITE) {
+        Push(layer, depth, sprite.texture, sprite.region, dest, tint);
+    }
+
+    // Sorts and draws everything queued, then empties the queue. Call it inside the same
+    // BeginMode2D() as the draws it replaces. Always ends by submitting the batch.
+    void Flush();
+
+    size_t Size() const { return commands.size(); }
+
+    const RenderStats &Stats() const { return stats; }
+    void ResetStats() { stats = RenderStats(); }
+
+private:
+    std::vector<SpriteCommand> commands;
+    RenderStats stats;
+};
+
+#endif // RENDER_QUEUE_H
@@ -0,0 +1,332 @@
+// simulation.cpp
+#include "Simulation.h"
+#include "GameConstants.h"
+#include "ProjectileCollision.h"
+#include <algorithm>
+
+int CalculateTargetScore(int level) {
+    return level == 1 ? 1000 : 1000 + (level - 1) * 3000;
+}
+
+// Runs Update() over one bucket of same-typed plants. T is the concrete class, so the
+// qualified call is bound at compile time and the whole bucket runs the same code.
+template <typename T>
+static void UpdatePlantBucket(std::vector<std::unique_ptr<T> > &bucket, float deltaTime, World &world,
+                              int &sunCurrency, Sound shootSound) {
+    for (auto &plant: bucket) {
+        if (plant->active) {
+            plant->T::Update(deltaTime, world, sunCurrency, shootSound);
+        }
+    }
+}
+
+template <typename T>
+static void UpdateZombieBucket(std::vector<std::unique_ptr<T> > &bucket, float deltaTime, World &world) {
+    for (auto &zombie: bucket) {
+        if (zombie->active) {
+            zombie->T::Update(deltaTime, world);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Entity Animations
+//----------------------------------------------------------------------------------
+EntityAnimations::EntityAnimations(const SimulationAssets &assets) {
+    // Plant sheets are a single still frame
+    peashooter.AddSheetRow("idle", assets.peashooterSprite, 1, 0, 1, 0.0f);
+    sunflower.AddSheetRow("idle", assets.sunflowerSprite, 1, 0, 1, 0.0f);
+    cherryBomb.AddSheetRow("idle", assets.cherryBombSprite, 1, 0, 1, 0.0f);
+    wallnut.AddSheetRow("idle", assets.wallnutSprite, 1, 0, 1, 0.0f);
+    repeater.AddSheetRow("idle", assets.repeaterSprite, 1, 0, 1, 0.0f);
+    icePea.AddSheetRow("idle", assets.icePeaPlantSprite, 1, 0, 1, 0.0f);
+
+    // Added in ZOMBIE_CLIP_* order: walking on the top row, eating on the one below
+    regularZombie.AddSheetRow("walk", assets.regularZombieSprite, REGULAR_ZOMBIE_TOTAL_SPRITE_ROWS, 0,
+                              REGULAR_ZOMBIE_WALKING_NUM_FRAMES, REGULAR_ZOMBIE_WALKING_FRAME_SPEED);
+    regularZombie.AddSheetRow("eat", assets.regularZombieSprite, REGULAR_ZOMBIE_TOTAL_SPRITE_ROWS, 1,
+                              REGULAR_ZOMBIE_EATING_NUM_FRAMES, REGULAR_ZOMBIE_EATING_FRAME_SPEED);
+    jumpingZombie.AddSheetRow("walk", assets.jumpingZombieSprite, JUMPING_ZOMBIE_TOTAL_SPRITE_ROWS, 0,
+                              JUMPING_ZOMBIE_NUM_FRAMES, JUMPING_ZOMBIE_FRAME_SPEED);
+}
+
+//----------------------------------------------------------------------------------
+// Simulation Implementation
+//----------------------------------------------------------------------------------
+Simulation::Simulation(const SimulationAssets &assets, float tickRate, const BoardConfig &board)
+    : world(board), assets(assets), animations(assets),
+      sunCurrency(50), score(0), currentLevel(1), targetScore(CalculateTargetScore(1)),
+      zombieSpawnTimer(0.0f), zombieSpawnRate(5.0f),
+      gameOver(false),
+      tickRate(tickRate), accumulator(0.0f),
+      jobs(nullptr),
+      laneResults(board.rows) {
+}
+
+Zombie *Simulation::SpawnZombie(ZombieType type, int row, float x) {
+    const BoardConfig &board = world.board;
+    Rectangle zombieRect = {
+        x,
+        board.TileY(row) + (board.tileSize / 4.0f),
+        board.tileSize / 2.0f * 2.8f,
+        board.tileSize / 2.0f * 2.8f
+    };
+
+    Lane &lane = world.GetLane(row);
+    Zombie *newZombie;
+    if (type == ZombieType::REGULAR) {
+        newZombie = EmplaceEntity(lane.regularZombies, zombieRect, row, animations.regularZombie, currentLevel);
+    } else {
+        newZombie = EmplaceEntity(lane.jumpingZombies, zombieRect, row, animations.jumpingZombie, currentLevel);
+    }
+
+    lane.InsertZombie(newZombie);
+    return newZombie;
+}
+
+void Simulation::SpawnRandomZombie(int row, float x) {
+    SpawnZombie(GetRandomValue(0, 1) == 0 ? ZombieType::REGULAR : ZombieType::JUMPING, row, x);
+}
+
+void Simulation::Reset(int level) {
+    world.Clear();
+
+    const BoardConfig &board = world.board;
+    for (int i = 0; i < board.rows; ++i) {
+        Rectangle mowerRect = {
+            board.originX - board.tileSize,
+            board.TileY(i),
+            board.tileSize / 2.0f * 1.8f,
+            board.tileSize / 2.0f * 1.8f
+        };
+        world.GetLane(i).mower = std::make_unique<LawnMower>(mowerRect, i, assets.lawnmowerSprite);
+    }
+
+    zombieSpawnTimer = 0.0f;
+    sunCurrency = 50;
+    score = 0;
+    gameOver = false;
+    accumulator = 0.0f;
+    currentLevel = level;
+    targetScore = CalculateTargetScore(currentLevel);
+
+    zombieSpawnRate = 5.0f - (currentLevel - 1) * 0.4f;
+    if (zombieSpawnRate < 1.0f) zombieSpawnRate = 1.0f;
+
+    int initialZombies = currentLevel * 2;
+    if (initialZombies > 10) initialZombies = 10;
+
+    for (int i = 0; i < initialZombies; ++i) {
+        int spawnRow = GetRandomValue(0, board.rows - 1);
+        SpawnRandomZombie(spawnRow, board.fieldRight + i * board.tileSize);
+    }
+}
+
+bool Simulation::PlacePlant(PlantType type, int row, int col) {
+    return world.VisitBoard([&](auto &lawn) { return PlacePlantOn(lawn, type, row, col); });
+}
+
+template <typename BoardT>
+bool Simulation::PlacePlantOn(BoardT &lawn, PlantType type, int row, int col) {
+    if (!lawn.InBounds(row, col) || lawn.PlantAt(row, col)) {
+        return false;
+    }
+
+    Lane &lane = lawn.lanes[row];
+    const BoardConfig &board = world.board;
+    Plant *newPlant = nullptr;
+    Rectangle plantRect = {
+        board.TileX(col) + (board.tileSize / 4.0f),
+        board.TileY(row) + (board.tileSize / 4.0f),
+        board.tileSize / 2.0f * 1.8f,
+        board.tileSize / 2.0f * 1.8f
+    };
+
+    switch (type) {
+        case PlantType::PEASHOOTER:
+            if (sunCurrency >= 50) newPlant = EmplaceEntity(lane.peashooters, plantRect, row, col, animations.peashooter);
+            break;
+        case PlantType::SUNFLOWER:
+            if (sunCurrency >= 25) newPlant = EmplaceEntity(lane.sunflowers, plantRect, row, col, animations.sunflower);
+            break;
+        case PlantType::CHERRY_BOMB:
+            if (sunCurrency >= 50) newPlant = EmplaceEntity(lane.cherryBombs, plantRect, row, col, animations.cherryBomb,
+                                                            assets.cherryBombExplosionSound);
+            break;
+        case PlantType::WALNUT:
+            if (sunCurrency >= 75) newPlant = EmplaceEntity(lane.wallnuts, plantRect, row, col, animations.wallnut);
+            break;
+        case PlantType::REPEATER:
+            if (sunCurrency >= 200) newPlant = EmplaceEntity(lane.repeaters, plantRect, row, col, animations.repeater);
+            break;
+        case PlantType::ICE_PEA:
+            if (sunCurrency >= 150) newPlant = EmplaceEntity(lane.icePeas, plantRect, row, col, animations.icePea);
+            break;
+        default:
+            break;
+    }
+
+    if (!newPlant) return false;
+
+    sunCurrency -= newPlant->GetCost();
+    lawn.SetPlantAt(row, col, newPlant);
+    return true;
+}
+
+bool Simulation::RemovePlant(int row, int col) {
+    return world.VisitBoard([&](auto &lawn) {
+        Plant *plant = lawn.PlantAt(row, col);
+        if (!plant) return false;
+
+        // Free the tile now; the plant itself is dropped by the next compaction pass in Step()
+        plant->active = false;
+        lawn.SetPlantAt(row, col, nullptr);
+        PlaySound(assets.digSound);
+        return true;
+    });
+}
+
+int Simulation::Advance(float frameTime) {
+    const float fixedDeltaTime = FixedDeltaTime();
+
+    accumulator += frameTime;
+    if (accumulator > SIM_MAX_STEPS_PER_FRAME * fixedDeltaTime) {
+        accumulator = SIM_MAX_STEPS_PER_FRAME * fixedDeltaTime;
+    }
+
+    int steps = 0;
+    while (accumulator >= fixedDeltaTime && !gameOver && !LevelComplete()) {
+        Step(fixedDeltaTime);
+        accumulator -= fixedDeltaTime;
+        ++steps;
+    }
+    return steps;
+}
+
+template <typename BoardT>
+void Simulation::ForEachLane(const BoardT &lawn, const std::function<void(int)> &fn) {
+    if (jobs) {
+        jobs->ParallelFor(lawn.Rows(), fn);
+    } else {
+        for (int row = 0; row < lawn.Rows(); ++row) fn(row);
+    }
+}
+
+void Simulation::UpdateLanePlants(int row, float deltaTime) {
+    Lane &lane = world.GetLane(row);
+    LaneStepResult &result = laneResults[row];
+
+    lane.ForEachPlantBucket([&](auto &bucket) {
+        UpdatePlantBucket(bucket, deltaTime, world, result.sunEarned, assets.shootSound);
+    });
+}
+
+void Simulation::UpdateLaneZombies(int row, float deltaTime) {
+    Lane &lane = world.GetLane(row);
+    const BoardConfig &board = world.board;
+    LaneStepResult &result = laneResults[row];
+
+    lane.ForEachZombieBucket([&](auto &bucket) { UpdateZombieBucket(bucket, deltaTime, world); });
+    lane.SortZombiesByX();
+
+    for (Zombie *zombie: lane.zombies) {
+        if (!zombie->active) continue;
+
+        if (zombie->rect.x <= board.originX - board.tileSize / 2) {
+            LawnMower *mower = lane.mower.get();
+            if (mower && !mower->activated) {
+                mower->activated = true;
+                world.QueueSound(row, assets.lawnmowerSound);
+            }
+        }
+
+        if (zombie->rect.x < board.originX - board.tileSize) {
+            result.reachedHouse = true;
+            return;
+        }
+    }
+
+    // Projectile movement and hits happen in the collision stage; the damage lands in the commit
+    ProjectileCollisionResult projectileHits = RunProjectileCollisionStage(lane, deltaTime, board.fieldRight);
+    if (projectileHits.hits > 0) {
+        world.QueueSound(row, assets.hitSound); // Replaying a sound restarts it, so once per tick is all that is audible
+    }
+
+    LawnMower *mower = lane.mower.get();
+    if (mower && mower->activated && mower->active) {
+        mower->Update(deltaTime);
+
+        // A mower only drives right along its own lane, so this tick it clears exactly the
+        // x-range it swept: one binary search into the sorted lane, then only the zombies hit
+        world.ForEachZombieInRange(row, row, mower->prevRect.x, mower->rect.x + mower->rect.width,
+                                   [&lane](Zombie &zombie) { lane.damage.Kill(&zombie); });
+        if (mower->rect.x > board.fieldRight + board.tileSize) {
+            mower->active = false;
+        }
+    }
+}
+
+void Simulation::Step(float deltaTime) {
+    if (gameOver) return;
+
+    // One dispatch per tick on the board storage; on the standard lawn every row loop in
+    // StepBoard then runs over a compile-time row count
+    world.VisitBoard([this, deltaTime](auto &lawn) { StepBoard(lawn, deltaTime); });
+}
+
+template <typename BoardT>
+void Simulation::StepBoard(BoardT &lawn, float deltaTime) {
+    // Remember where everything was so the renderer can interpolate towards this tick
+    // (projectiles do this themselves in ProjectileStore::Move)
+    for (auto &lane: lawn.lanes) {
+        for (auto &zombie: lane.zombies) zombie->prevRect = zombie->rect;
+        if (lane.mower) lane.mower->prevRect = lane.mower->rect;
+    }
+
+    zombieSpawnTimer += deltaTime;
+    if (zombieSpawnTimer >= zombieSpawnRate) {
+        zombieSpawnTimer = 0.0f;
+        int spawnRow = GetRandomValue(0, lawn.Rows() - 1);
+        SpawnRandomZombie(spawnRow, world.board.fieldRight);
+    }
+
+    // Each lane is stepped on its own (as a job when there is a job system) and only writes
+    // to itself: its plants, zombies, peas, mower, damage queue, sounds and laneResults slot.
+    // Plants go first for every lane, because a Cherry Bomb reads the zombies of the lanes
+    // next to it and they must not be moving while it looks.
+    std::fill(laneResults.begin(), laneResults.end(), LaneStepResult());
+    ForEachLane(lawn, [this, deltaTime](int row) { UpdateLanePlants(row, deltaTime); });
+    // The blasts queued so far are subtracted from the health the peas aim at, so no pea
+    // is spent on a zombie that is already going to die at the commit
+    for (auto &lane: lawn.lanes) {
+        lane.damage.MarkPending();
+    }
+    ForEachLane(lawn, [this, deltaTime](int row) { UpdateLaneZombies(row, deltaTime); });
+
+    // Merge in lane order, so the outcome is the same however the lanes were scheduled
+    bool reachedHouse = false;
+    for (int row = 0; row < lawn.Rows(); ++row) {
+        Lane &lane = lawn.lanes[row];
+        sunCurrency += laneResults[row].sunEarned;
+        reachedHouse = reachedHouse || laneResults[row].reachedHouse;
+        for (const Sound &sound: lane.sounds) {
+            PlaySound(sound);
+        }
+        lane.sounds.clear();
+    }
+
+    if (reachedHouse) {
+        gameOver = true;
+        PlaySound(assets.gameOverSound);
+        return;
+    }
+
+    // Commit phase: every queued hit, blast and mowing lands at once, and this is the only
+    // place zombies die and score is awarded
+    for (auto &lane: lawn.lanes) {
+        score += lane.damage.Commit();
+    }
+
+    // Dead zombies, spent projectiles and eaten/exploded/shovelled plants go in one pass per lane
+    ForEachLane(lawn, [this](int row) { world.CompactLane(row); });
+}
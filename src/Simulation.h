@@ -0,0 +1,156 @@
+// simulation.h
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "raylib.h"
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+#include "Plant.h"
+#include "Zombie.h"
+#include "Projectile.h"
+#include "LawnMower.h"
+#include "World.h"
+#include "GameConstants.h"
+#include "JobSystem.h"
+#include "Sprite.h"
+#include "Animation.h"
+
+//----------------------------------------------------------------------------------
+// Simulation Assets
+//----------------------------------------------------------------------------------
+// Sprites and sounds handed to the entities the simulation creates.
+// A headless run leaves everything zeroed: sprites are only sampled by the Draw
+// functions and raylib ignores a Sound without an audio buffer, so no window,
+// GPU or audio device is required to step the game.
+struct SimulationAssets {
+    Sprite peashooterSprite;
+    Sprite sunflowerSprite;
+    Sprite cherryBombSprite;
+    Sprite wallnutSprite;
+    Sprite repeaterSprite;
+    Sprite icePeaPlantSprite;
+    Sprite regularZombieSprite;
+    Sprite jumpingZombieSprite;
+    Sprite peaSprite;              // Only used when drawing projectiles
+    Sprite icePeaProjectileSprite; // Only used when drawing projectiles
+    Sprite lawnmowerSprite;
+
+    Sound shootSound = {};
+    Sound hitSound = {};
+    Sound gameOverSound = {};
+    Sound cherryBombExplosionSound = {};
+    Sound lawnmowerSound = {};
+    Sound digSound = {};
+};
+
+// Frame tables for every plant and zombie type, cut from the asset sprites once when the
+// Simulation is created. Entities point at their type's set and keep only an AnimationState.
+struct EntityAnimations {
+    AnimationSet peashooter;
+    AnimationSet sunflower;
+    AnimationSet cherryBomb;
+    AnimationSet wallnut;
+    AnimationSet repeater;
+    AnimationSet icePea;
+    AnimationSet regularZombie;
+    AnimationSet jumpingZombie;
+
+    explicit EntityAnimations(const SimulationAssets &assets);
+};
+
+int CalculateTargetScore(int level);
+
+// What one lane hands back to the merge after it has been stepped
+struct LaneStepResult {
+    int sunEarned = 0;
+    bool reachedHouse = false;
+};
+
+//----------------------------------------------------------------------------------
+// Simulation Class
+//----------------------------------------------------------------------------------
+// Owns every gameplay entity and advances them with Step(). Nothing in here opens
+// a window or touches the GPU, so it can run in batch jobs and benchmarks as fast
+// as the CPU allows; main.cpp only feeds it input and draws the result.
+class Simulation {
+public:
+    World world; // Plants, zombies, projectiles and mowers, bucketed by lane
+
+    SimulationAssets assets;
+    EntityAnimations animations; // Built from assets; the entities in world point into it
+
+    int sunCurrency;
+    int score;
+    int currentLevel;
+    int targetScore;
+
+    float zombieSpawnTimer;
+    float zombieSpawnRate;
+
+    bool gameOver; // Set when a zombie reaches the house; Step() does nothing until Reset()
+
+    float tickRate; // Fixed simulation ticks per second
+    float accumulator; // Frame time not yet consumed by a fixed tick
+
+    // Optional, not owned. When set, Step() updates the lanes as jobs on it; the merge
+    // afterwards runs in lane order, so results are identical to a single-threaded run.
+    JobSystem *jobs;
+
+    explicit Simulation(const SimulationAssets &assets = SimulationAssets(), float tickRate = SIM_TICK_RATE,
+                        const BoardConfig &board = BoardConfig());
+
+    // Clears the board and sets up a fresh run of the given level
+    void Reset(int level);
+
+    // Advances the whole board by deltaTime seconds
+    void Step(float deltaTime);
+
+    // Feeds a variable render frame time into the accumulator and runs as many fixed
+    // ticks as it covers (at most SIM_MAX_STEPS_PER_FRAME). Returns the number of ticks run.
+    int Advance(float frameTime);
+
+    float FixedDeltaTime() const { return 1.0f / tickRate; }
+
+    // How far the render frame sits between the previous tick (0) and the latest one (1).
+    // Clamped, because Advance() leaves time in the accumulator when it stops early (game
+    // over or level complete) and the halted board must not be drawn extrapolated.
+    float InterpolationAlpha() const { return std::clamp(accumulator / FixedDeltaTime(), 0.0f, 1.0f); }
+
+    bool LevelComplete() const { return score >= targetScore; }
+
+    // Buys and places a plant on an empty tile. Returns false if the tile is taken
+    // or there is not enough sun.
+    bool PlacePlant(PlantType type, int row, int col);
+
+    // Shovel: removes the plant on the given tile. Returns false if the tile is empty.
+    bool RemovePlant(int row, int col);
+
+    // Adds a zombie of the given type at x in the given row, scaled to the current level
+    Zombie *SpawnZombie(ZombieType type, int row, float x);
+
+private:
+    std::vector<LaneStepResult> laneResults; // One slot per lane, written only by that lane's step
+
+    // Regular or jumping with equal odds, as the wave spawner does
+    void SpawnRandomZombie(int row, float x);
+
+    // Step() and PlacePlant() for one kind of board storage (see World::VisitBoard)
+    template <typename BoardT>
+    void StepBoard(BoardT &lawn, float deltaTime);
+
+    template <typename BoardT>
+    bool PlacePlantOn(BoardT &lawn, PlantType type, int row, int col);
+
+    // Runs fn for every row, spread over the job system if there is one
+    template <typename BoardT>
+    void ForEachLane(const BoardT &lawn, const std::function<void(int)> &fn);
+
+    // The two per-lane phases of Step(). Each only writes to its own lane.
+    void UpdateLanePlants(int row, float deltaTime);
+    void UpdateLaneZombies(int row, float deltaTime); // Zombies, peas and the mower
+};
+
+#endif // SIMULATION_H
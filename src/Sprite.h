@@ -0,0 +1,24 @@
+// sprite.h
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Sprite
+//----------------------------------------------------------------------------------
+// A picture inside a texture: the whole texture for a standalone image, or one packed
+// region of the atlas. Entities draw through their sprite's region, so they never need
+// to know which texture they live in. Plain data, so the headless simulation can hold
+// sprites without linking any of the render code.
+struct Sprite {
+    Texture2D texture = {};
+    Rectangle region = {}; // In texture pixels
+};
+
+// A sprite covering all of texture
+inline Sprite SpriteFromTexture(Texture2D texture) {
+    return {texture, {0, 0, (float) texture.width, (float) texture.height}};
+}
+
+#endif // SPRITE_H
@@ -0,0 +1,190 @@
+// stress_test.cpp
+#include "StressTest.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//----------------------------------------------------------------------------------
+// Option Parsing
+//----------------------------------------------------------------------------------
+static void PrintStressUsage() {
+    std::fprintf(stderr,
+                 "Stress mode options:\n"
+                 "  --stress                       start straight into a stress run\n"
+                 "  --stress-mix P,R,I,W           plant weights: Peashooter, Repeater, Ice Pea, Wall-nut\n"
+                 "  --stress-spawn-interval <s>    seconds between zombie waves\n"
+                 "  --stress-spawn-count <n>       zombies per wave\n"
+                 "  --stress-duration <s>          quit after this many seconds (0 = run until closed)\n");
+}
+
+bool ParseStressArgs(int argc, char **argv, StressConfig &config) {
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--stress") == 0) {
+            config.enabled = true;
+        } else if (std::strcmp(arg, "--stress-mix") == 0 && hasValue) {
+            int weights[4];
+            if (std::sscanf(argv[++i], "%d,%d,%d,%d", &weights[0], &weights[1], &weights[2], &weights[3]) != 4 ||
+                std::min({weights[0], weights[1], weights[2], weights[3]}) < 0 ||
+                weights[0] + weights[1] + weights[2] + weights[3] == 0) {
+                PrintStressUsage();
+                return false;
+            }
+            config.peashooterWeight = weights[0];
+            config.repeaterWeight = weights[1];
+            config.icePeaWeight = weights[2];
+            config.wallnutWeight = weights[3];
+            config.enabled = true;
+        } else if (std::strcmp(arg, "--stress-spawn-interval") == 0 && hasValue) {
+            config.zombieSpawnInterval = (float) std::atof(argv[++i]);
+            if (config.zombieSpawnInterval <= 0.0f) {
+                PrintStressUsage();
+                return false;
+            }
+            config.enabled = true;
+        } else if (std::strcmp(arg, "--stress-spawn-count") == 0 && hasValue) {
+            config.zombiesPerSpawn = std::atoi(argv[++i]);
+            if (config.zombiesPerSpawn < 1) {
+                PrintStressUsage();
+                return false;
+            }
+            config.enabled = true;
+        } else if (std::strcmp(arg, "--stress-duration") == 0 && hasValue) {
+            config.duration = std::max(0.0f, (float) std::atof(argv[++i]));
+            config.enabled = true;
+        } else if (std::strncmp(arg, "--stress", 8) == 0) {
+            PrintStressUsage();
+            return false;
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Stress Driver Implementation
+//----------------------------------------------------------------------------------
+StressDriver::StressDriver(const StressConfig &config)
+    : config(config), spawnTimer(0.0f), restarts(0) {
+}
+
+// The plant for a tile: the weights are laid out as one repeating pattern across the lawn,
+// so the mix is the same on every run
+static PlantType StressPlantForTile(const StressConfig &config, int cols, int row, int col) {
+    int total = config.peashooterWeight + config.repeaterWeight + config.icePeaWeight + config.wallnutWeight;
+    int slot = (int) (((long long) row * cols + col) % total);
+
+    if (slot < config.peashooterWeight) return PlantType::PEASHOOTER;
+    slot -= config.peashooterWeight;
+    if (slot < config.repeaterWeight) return PlantType::REPEATER;
+    slot -= config.repeaterWeight;
+    if (slot < config.icePeaWeight) return PlantType::ICE_PEA;
+    return PlantType::WALNUT;
+}
+
+// Plants every empty tile; sun is topped up first so the purchase never fails.
+// This scans the whole lawn every frame, so it walks the board storage directly.
+static void ReplantEmptyTiles(Simulation &sim, const StressConfig &config) {
+    sim.sunCurrency = INT_MAX / 2;
+    sim.world.VisitBoard([&](const auto &lawn) {
+        for (int row = 0; row < lawn.Rows(); ++row) {
+            for (int col = 0; col < lawn.Cols(); ++col) {
+                if (!lawn.PlantAt(row, col)) {
+                    sim.PlacePlant(StressPlantForTile(config, lawn.Cols(), row, col), row, col);
+                }
+            }
+        }
+    });
+}
+
+void StressDriver::Populate(Simulation &sim) {
+    sim.Reset(1);
+    sim.targetScore = INT_MAX; // The level never completes
+    spawnTimer = 0.0f;
+    ReplantEmptyTiles(sim, config);
+}
+
+void StressDriver::Update(Simulation &sim, float frameTime) {
+    if (sim.gameOver) {
+        ++restarts;
+        Populate(sim);
+        return;
+    }
+
+    // Eaten plants grow straight back so the load stays at a full lawn
+    ReplantEmptyTiles(sim, config);
+
+    // After a long hitch only catch up a quarter second of waves, so one bad frame
+    // cannot flood the board and make every following frame bad as well
+    spawnTimer = std::min(spawnTimer + frameTime, std::max(0.25f, config.zombieSpawnInterval));
+    while (spawnTimer >= config.zombieSpawnInterval) {
+        spawnTimer -= config.zombieSpawnInterval;
+        for (int i = 0; i < config.zombiesPerSpawn; ++i) {
+            ZombieType type = GetRandomValue(0, 1) == 0 ? ZombieType::REGULAR : ZombieType::JUMPING;
+            sim.SpawnZombie(type, GetRandomValue(0, sim.world.Rows() - 1), sim.world.board.fieldRight);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Frame Stats Implementation
+//----------------------------------------------------------------------------------
+void FrameStats::AddFrame(float frame, float driver, float update, float draw, size_t entityCount,
+                          size_t projectileCount, const RenderStats &render) {
+    frameMs.push_back(frame);
+    driverMs.push_back(driver);
+    updateMs.push_back(update);
+    drawMs.push_back(draw);
+    sprites.push_back((float) render.sprites);
+    drawCalls.push_back((float) render.drawCalls);
+    batchFlushes.push_back((float) render.batchFlushes);
+    entities.push_back(entityCount);
+    peakEntities = std::max(peakEntities, entityCount);
+    peakProjectiles = std::max(peakProjectiles, projectileCount);
+}
+
+static void PrintSeries(const char *name, std::vector<float> samples, const char *unit = "ms") {
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (float sample: samples) sum += sample;
+
+    auto percentile = [&samples](double p) { return samples[(size_t) (p * (samples.size() - 1))]; };
+    std::printf("  %-8s min %7.2f  mean %7.2f  p50 %7.2f  p95 %7.2f  p99 %7.2f  max %7.2f %s\n",
+                name, samples.front(), sum / samples.size(), percentile(0.50), percentile(0.95), percentile(0.99),
+                samples.back(), unit);
+}
+
+void FrameStats::Print() const {
+    if (frameMs.empty()) {
+        std::printf("Stress test: no frames recorded\n");
+        return;
+    }
+
+    const float budgetMs = 1000.0f / 60.0f;
+    size_t missed = 0;
+    size_t firstMissEntities = 0;
+    for (size_t i = 0; i < frameMs.size(); ++i) {
+        if (frameMs[i] > budgetMs) {
+            if (missed == 0) firstMissEntities = entities[i];
+            ++missed;
+        }
+    }
+
+    std::printf("Stress test: %zu frames\n", frameMs.size());
+    PrintSeries("frame", frameMs);
+    PrintSeries("driver", driverMs);
+    PrintSeries("update", updateMs);
+    PrintSeries("draw", drawMs);
+    std::printf("  per frame:\n");
+    PrintSeries("sprites", sprites, "");
+    PrintSeries("draws", drawCalls, "");
+    PrintSeries("flushes", batchFlushes, "");
+    std::printf("  frames over %.2f ms (60 FPS): %zu (%.1f%%)\n", budgetMs, missed, 100.0 * missed / frameMs.size());
+    if (missed > 0) {
+        std::printf("  first missed frame at %zu entities\n", firstMissEntities);
+    }
+    std::printf("  peak entities %zu, peak projectiles %zu\n", peakEntities, peakProjectiles);
+}
@@ -0,0 +1,85 @@
+// stress_test.h
+#ifndef STRESS_TEST_H
+#define STRESS_TEST_H
+
+#include <vector>
+#include <cstddef>
+
+#include "Simulation.h"
+#include "RenderQueue.h"
+
+//----------------------------------------------------------------------------------
+// Stress Test Config
+//----------------------------------------------------------------------------------
+// Launch options for the stress mode (main.cpp --stress). The lawn is filled with a
+// weighted mix of attacking plants and zombies keep arriving at a fixed rate, far
+// past what the level curve in Simulation::Reset would ever produce.
+struct StressConfig {
+    bool enabled = false;
+
+    // Relative weights of each plant in the mix; every tile gets one plant
+    int peashooterWeight = 4;
+    int repeaterWeight = 2;
+    int icePeaWeight = 2;
+    int wallnutWeight = 1;
+
+    float zombieSpawnInterval = 0.1f; // Seconds between spawn waves
+    int zombiesPerSpawn = 1; // Zombies per wave, each in a random lane
+
+    float duration = 0.0f; // Seconds before the game closes by itself, 0 to run until the window is closed
+};
+
+// Reads the --stress* options. Returns false (after printing usage) on a bad option;
+// anything it does not recognise is left for the caller.
+bool ParseStressArgs(int argc, char **argv, StressConfig &config);
+
+//----------------------------------------------------------------------------------
+// Stress Driver
+//----------------------------------------------------------------------------------
+// Keeps a Simulation saturated: plants every tile, feeds zombies at the configured
+// rate, never lets the level complete and rebuilds the board when the house falls.
+class StressDriver {
+public:
+    StressConfig config;
+    float spawnTimer;
+    int restarts; // Times the zombies broke through and the board was rebuilt
+
+    explicit StressDriver(const StressConfig &config);
+
+    // Resets the simulation to a fully planted lawn
+    void Populate(Simulation &sim);
+
+    // Spawns this frame's zombies; call once per frame before Simulation::Advance()
+    void Update(Simulation &sim, float frameTime);
+};
+
+//----------------------------------------------------------------------------------
+// Frame Stats
+//----------------------------------------------------------------------------------
+// Per-frame timings and render counts collected during a stress run and summarised on exit
+class FrameStats {
+public:
+    // frameMs is this frame's wall time from the top of the loop to after EndDrawing(), with the
+    // frame cap off; driverMs is the StressDriver's own work that frame; updateMs covers only
+    // Simulation::Advance()
+    void AddFrame(float frameMs, float driverMs, float updateMs, float drawMs, size_t entities,
+                  size_t projectiles, const RenderStats &render);
+
+    // Prints min / mean / percentiles / max for each series, plus how many frames
+    // missed the 60 FPS budget and the entity counts they were seen at
+    void Print() const;
+
+private:
+    std::vector<float> frameMs;
+    std::vector<float> driverMs;
+    std::vector<float> updateMs;
+    std::vector<float> drawMs;
+    std::vector<float> sprites;
+    std::vector<float> drawCalls;
+    std::vector<float> batchFlushes;
+    std::vector<size_t> entities;
+    size_t peakEntities = 0;
+    size_t peakProjectiles = 0;
+};
+
+#endif // STRESS_TEST_H
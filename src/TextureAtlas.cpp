@@ -0,0 +1,87 @@
+// texture_atlas.cpp
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <numeric>
+
+//----------------------------------------------------------------------------------
+// Sprite Implementation
+//----------------------------------------------------------------------------------
+void DrawSprite(const Sprite &sprite, Rectangle dest, Color tint) {
+    DrawTexturePro(sprite.texture, sprite.region, dest, {0, 0}, 0.0f, tint);
+}
+
+//----------------------------------------------------------------------------------
+// Texture Atlas Implementation
+//----------------------------------------------------------------------------------
+bool TextureAtlas::Pack(const std::vector<Image> &images, int maxSize,
+                        std::vector<Rectangle> &regions, int &width, int &height) {
+    // Tallest first keeps the shelves tight
+    std::vector<size_t> order(images.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&images](size_t a, size_t b) { return images[a].height > images[b].height; });
+
+    int widest = 0;
+    for (const Image &image: images) widest = std::max(widest, image.width + 2 * PADDING);
+
+    // Try power-of-two sheet widths until the result is no taller than it is wide
+    for (width = 64; width <= maxSize; width *= 2) {
+        if (width < widest) continue;
+
+        regions.assign(images.size(), Rectangle{0, 0, 0, 0});
+        int shelfX = 0, shelfY = 0, shelfHeight = 0;
+        for (size_t i: order) {
+            const Image &image = images[i];
+            if (image.data == nullptr || image.width <= 0 || image.height <= 0) continue;
+
+            int w = image.width + 2 * PADDING;
+            int h = image.height + 2 * PADDING;
+            if (shelfX + w > width) {
+                shelfY += shelfHeight;
+                shelfX = 0;
+                shelfHeight = 0;
+            }
+            regions[i] = {(float) (shelfX + PADDING), (float) (shelfY + PADDING), (float) image.width, (float) image.height};
+            shelfX += w;
+            shelfHeight = std::max(shelfHeight, h);
+        }
+        height = std::max(1, shelfY + shelfHeight);
+
+        if (height <= width || (width * 2 > maxSize && height <= maxSize)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TextureAtlas::Build(const std::vector<Image> &images, std::vector<Sprite> &sprites, int maxSize) {
+    std::vector<Rectangle> regions;
+    int width = 0, height = 0;
+    if (!Pack(images, maxSize, regions, width, height)) {
+        TraceLog(LOG_WARNING, "ATLAS: %zu images do not fit in %dx%d", images.size(), maxSize, maxSize);
+        return false;
+    }
+
+    Image sheet = GenImageColor(width, height, BLANK);
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (regions[i].width <= 0) continue;
+        const Image &image = images[i];
+        ImageDraw(&sheet, image, {0, 0, (float) image.width, (float) image.height}, regions[i], WHITE);
+    }
+    texture = LoadTextureFromImage(sheet);
+    UnloadImage(sheet);
+
+    sprites.clear();
+    for (const Rectangle &region: regions) {
+        sprites.push_back(region.width > 0 ? Sprite{texture, region} : Sprite());
+    }
+    TraceLog(LOG_INFO, "ATLAS: packed %zu images into %dx%d", images.size(), width, height);
+    return true;
+}
+
+void TextureAtlas::Unload() {
+    if (texture.id > 0) {
+        UnloadTexture(texture);
+    }
+    texture = {};
+}
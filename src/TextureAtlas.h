@@ -0,0 +1,43 @@
+// texture_atlas.h
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include "raylib.h"
+#include <vector>
+
+#include "Sprite.h"
+
+// Draws the whole sprite stretched over dest
+void DrawSprite(const Sprite &sprite, Rectangle dest, Color tint);
+
+//----------------------------------------------------------------------------------
+// Texture Atlas
+//----------------------------------------------------------------------------------
+// Packs many small images into one texture at startup. Every sprite in the atlas shares
+// the same texture, so raylib can keep drawing them into one batch instead of flushing
+// it whenever consecutive draws switch textures.
+//
+// Images are placed with a shelf packer: tallest first, left to right along rows whose
+// height is set by their first image. There is a transparent gutter around every image
+// so that filtering and fractional frame widths never pull in a neighbour's pixels.
+class TextureAtlas {
+public:
+    Texture2D texture = {};
+
+    // Packs images (decoded on any thread) into one sheet and uploads it, so it must be
+    // called from the thread that owns the GL context. sprites gets one entry per image,
+    // in order; images that failed to load get an empty sprite. The images are not freed.
+    // Returns false, leaving nothing uploaded, if they do not fit in maxSize x maxSize.
+    bool Build(const std::vector<Image> &images, std::vector<Sprite> &sprites, int maxSize = 4096);
+
+    void Unload();
+
+    static const int PADDING = 2; // Transparent gutter around every image, in pixels
+
+private:
+    // Works out where each image goes; returns false if it does not fit in maxSize
+    static bool Pack(const std::vector<Image> &images, int maxSize,
+                     std::vector<Rectangle> &regions, int &width, int &height);
+};
+
+#endif // TEXTURE_ATLAS_H
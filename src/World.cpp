@@ -0,0 +1,158 @@
+// world.cpp
+#include "World.h"
+#include "GameConstants.h"
+#include <algorithm>
+#include <cmath>
+
+//----------------------------------------------------------------------------------
+// World Implementation
+//----------------------------------------------------------------------------------
+DynamicBoard::DynamicBoard(int rows, int cols, size_t projectileLaneLimit)
+    : occupancy((size_t) rows * cols, nullptr), rows(rows), cols(cols) {
+    lanes.reserve(rows);
+    for (int i = 0; i < rows; ++i) {
+        lanes.emplace_back(projectileLaneLimit);
+    }
+}
+
+static std::variant<StandardBoard, DynamicBoard> MakeBoardStorage(const BoardConfig &board,
+                                                                 size_t projectileLaneLimit) {
+    if (board.rows == StandardBoard::Rows() && board.cols == StandardBoard::Cols()) {
+        return std::variant<StandardBoard, DynamicBoard>(std::in_place_type<StandardBoard>, projectileLaneLimit);
+    }
+    return std::variant<StandardBoard, DynamicBoard>(std::in_place_type<DynamicBoard>, board.rows, board.cols,
+                                                     projectileLaneLimit);
+}
+
+World::World(const BoardConfig &board)
+    : board(board), storage(MakeBoardStorage(board, board.MaxLaneProjectiles())) {
+    VisitBoard([this](auto &lawn) {
+        lanes = LaneSpan{lawn.lanes.data(), lawn.lanes.size()};
+    });
+}
+
+size_t Lane::PlantCount() const {
+    size_t count = 0;
+    ForEachPlantBucket([&count](const auto &bucket) { count += bucket.size(); });
+    return count;
+}
+
+void Lane::InsertZombie(Zombie *zombie) {
+    auto position = std::upper_bound(zombies.begin(), zombies.end(), zombie->rect.x,
+                                     [](float x, const Zombie *other) { return x < other->rect.x; });
+    zombies.insert(position, zombie);
+    maxZombieWidth = std::max(maxZombieWidth, zombie->rect.width);
+}
+
+size_t Lane::FirstZombieFrom(float x) const {
+    auto it = std::lower_bound(zombies.begin(), zombies.end(), x,
+                               [](const Zombie *zombie, float value) { return zombie->rect.x < value; });
+    return it - zombies.begin();
+}
+
+void Lane::SortZombiesByX() {
+    for (size_t i = 1; i < zombies.size(); ++i) {
+        Zombie *zombie = zombies[i];
+        size_t j = i;
+        while (j > 0 && zombies[j - 1]->rect.x > zombie->rect.x) {
+            zombies[j] = zombies[j - 1];
+            --j;
+        }
+        zombies[j] = zombie;
+    }
+}
+
+void World::Clear() {
+    for (auto &lane: lanes) {
+        lane.ForEachPlantBucket([](auto &bucket) { bucket.clear(); });
+        lane.zombies.clear();
+        lane.maxZombieWidth = 0.0f;
+        lane.ForEachZombieBucket([](auto &bucket) { bucket.clear(); });
+        lane.mower.reset();
+        lane.projectiles.Clear();
+        lane.damage.Clear();
+        lane.sounds.clear();
+    }
+    VisitBoard([](auto &lawn) { lawn.ClearTiles(); });
+}
+
+void World::Compact() {
+    for (int row = 0; row < board.rows; ++row) {
+        CompactLane(row);
+    }
+}
+
+void World::CompactLane(int row) {
+    Lane &lane = lanes[row];
+    VisitBoard([&lane](auto &lawn) {
+        lane.ForEachPlantBucket([&lawn](auto &bucket) {
+            for (const auto &plant: bucket) {
+                if (!plant->active && lawn.PlantAt(plant->row, plant->col) == plant.get()) {
+                    lawn.SetPlantAt(plant->row, plant->col, nullptr);
+                }
+            }
+            SwapAndPopInactive(bucket);
+        });
+    });
+
+    // The combined list goes first: it only holds pointers into the buckets.
+    // It is erased in order so it stays sorted by x.
+    EraseInactiveStable(lane.zombies);
+    lane.ForEachZombieBucket([](auto &bucket) { SwapAndPopInactive(bucket); });
+    lane.projectiles.Compact();
+}
+
+Zombie *World::FirstZombieAhead(int row, float x) const {
+    const std::vector<Zombie *> &zombies = lanes[row].zombies;
+    auto it = std::upper_bound(zombies.begin(), zombies.end(), x,
+                               [](float value, const Zombie *zombie) { return value < zombie->rect.x; });
+
+    // Dead zombies stay in the list until the end-of-tick compaction; skip past them
+    for (; it != zombies.end(); ++it) {
+        if ((*it)->active) {
+            return *it;
+        }
+    }
+    return nullptr;
+}
+
+Plant *World::PlantTouching(int row, Rectangle rect) const {
+    // Plants are drawn slightly larger than 3/4 of a tile from a 1/4 tile inset, so a plant
+    // can overhang into the tile to its right; start one tile early to catch it.
+    int firstCol = board.ColumnAt(rect.x) - 1;
+    int lastCol = board.ColumnAt(rect.x + rect.width);
+
+    return VisitBoard([&](const auto &lawn) -> Plant * {
+        for (int col = lawn.ClampCol(firstCol); col <= lawn.ClampCol(lastCol); ++col) {
+            Plant *plant = lawn.PlantAt(row, col);
+            if (plant && plant->active && CheckCollisionRecs(rect, plant->rect)) {
+                return plant;
+            }
+        }
+        return nullptr;
+    });
+}
+
+size_t World::PlantCount() const {
+    size_t count = 0;
+    for (const auto &lane: lanes) count += lane.PlantCount();
+    return count;
+}
+
+size_t World::ZombieCount() const {
+    size_t count = 0;
+    for (const auto &lane: lanes) count += lane.zombies.size();
+    return count;
+}
+
+size_t World::ProjectileCount() const {
+    size_t count = 0;
+    for (const auto &lane: lanes) count += lane.projectiles.Count();
+    return count;
+}
+
+size_t World::DroppedProjectileCount() const {
+    size_t count = 0;
+    for (const auto &lane: lanes) count += lane.projectiles.DroppedCount();
+    return count;
+}
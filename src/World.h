@@ -0,0 +1,339 @@
+// world.h
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <vector>
+#include <array>
+#include <variant>
+#include <utility>
+#include <memory>
+#include <algorithm>
+
+#include "Plant.h"
+#include "Zombie.h"
+#include "Projectile.h"
+#include "LawnMower.h"
+#include "DamageEvents.h"
+#include "GameConstants.h"
+#include "BoardConfig.h"
+
+//----------------------------------------------------------------------------------
+// Lane
+//----------------------------------------------------------------------------------
+// Everything living on one row of the lawn. Entities never change rows, so
+// targeting, bites, projectile hits and the mower only ever look inside one lane.
+//
+// Plants and zombies are owned in one bucket per concrete type, so the update pass can
+// run each bucket with a statically bound Update() instead of hopping between vtables.
+struct Lane {
+    std::vector<std::unique_ptr<Peashooter> > peashooters;
+    std::vector<std::unique_ptr<Sunflower> > sunflowers;
+    std::vector<std::unique_ptr<CherryBomb> > cherryBombs;
+    std::vector<std::unique_ptr<WallNut> > wallnuts;
+    std::vector<std::unique_ptr<Repeater> > repeaters;
+    std::vector<std::unique_ptr<IcePea> > icePeas;
+
+    std::vector<std::unique_ptr<RegularZombie> > regularZombies;
+    std::vector<std::unique_ptr<JumpingZombie> > jumpingZombies;
+
+    // Every zombie in the lane regardless of type (non-owning), kept sorted by rect.x so the
+    // leftmost zombie past any point is a binary search away
+    std::vector<Zombie *> zombies;
+    float maxZombieWidth = 0.0f; // Widest zombie ever added; lets a range query start its search early enough
+
+    std::unique_ptr<LawnMower> mower;
+    ZombieHitboxes hitboxes; // Sorted copy of the zombie rects, rebuilt each tick for projectile hits
+    ProjectileStore projectiles; // Peas fired along this lane
+
+    // Written while the lane is stepped and drained by the Simulation afterwards, so lanes
+    // can be stepped on separate threads without sharing anything
+    DamageQueue damage; // Zombie damage caused by this lane's plants, peas and mower
+    std::vector<Sound> sounds; // Sounds to play once the tick is merged
+
+    explicit Lane(size_t projectileLimit) : projectiles(projectileLimit) {}
+
+    // Calls fn with every plant bucket. fn gets the bucket itself, so a generic lambda
+    // sees the concrete element type and its calls bind statically.
+    template <typename Fn>
+    void ForEachPlantBucket(Fn &&fn) {
+        fn(peashooters);
+        fn(sunflowers);
+        fn(cherryBombs);
+        fn(wallnuts);
+        fn(repeaters);
+        fn(icePeas);
+    }
+
+    template <typename Fn>
+    void ForEachPlantBucket(Fn &&fn) const {
+        fn(peashooters);
+        fn(sunflowers);
+        fn(cherryBombs);
+        fn(wallnuts);
+        fn(repeaters);
+        fn(icePeas);
+    }
+
+    template <typename Fn>
+    void ForEachZombieBucket(Fn &&fn) {
+        fn(regularZombies);
+        fn(jumpingZombies);
+    }
+
+    // Adds a zombie to the sorted list at its place by x
+    void InsertZombie(Zombie *zombie);
+
+    // Index of the first zombie in the sorted list whose left edge is at or past x
+    size_t FirstZombieFrom(float x) const;
+
+    // Restores the x order after zombies have moved. Zombies only walk left and rarely pass
+    // each other, so this is an insertion sort that does almost no work on a normal tick.
+    void SortZombiesByX();
+
+    size_t PlantCount() const;
+};
+
+// Constructs an entity at the end of a typed bucket and returns a pointer to it
+template <typename T, typename... Args>
+T *EmplaceEntity(std::vector<std::unique_ptr<T> > &bucket, Args &&... args) {
+    bucket.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+    return bucket.back().get();
+}
+
+// Drops every inactive entity in a single pass. Each hole is filled by moving the
+// last element into it, so nothing is shifted and order is not preserved.
+template <typename EntityPtr>
+void SwapAndPopInactive(std::vector<EntityPtr> &entities) {
+    size_t i = 0;
+    while (i < entities.size()) {
+        if (!entities[i]->active) {
+            entities[i] = std::move(entities.back());
+            entities.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
+
+// Drops every inactive entity like SwapAndPopInactive, but keeps the survivors in order
+template <typename EntityPtr>
+void EraseInactiveStable(std::vector<EntityPtr> &entities) {
+    entities.erase(std::remove_if(entities.begin(), entities.end(),
+                                  [](const EntityPtr &entity) { return !entity->active; }),
+                   entities.end());
+}
+
+//----------------------------------------------------------------------------------
+// Board Storage
+//----------------------------------------------------------------------------------
+// The lanes and occupancy table of a lawn. Board<RowCount, ColCount> sizes both at compile
+// time as std::arrays, so a loop over its rows or tiles has a constant trip count the
+// compiler can unroll, and its bounds checks, clamps and tile index math compare against
+// constants. DynamicBoard has the same interface with the sizes picked at runtime, for
+// arenas. World::VisitBoard() hands out whichever one the World holds with its real type.
+
+// Tile operations shared by both boards, written against the derived board's Rows() and
+// Cols(), which are constexpr on Board<RowCount, ColCount>
+template <typename Derived>
+class BoardTiles {
+public:
+    bool InBounds(int row, int col) const {
+        return row >= 0 && row < Self().Rows() && col >= 0 && col < Self().Cols();
+    }
+
+    int TileIndex(int row, int col) const { return row * Self().Cols() + col; }
+
+    int ClampRow(int row) const { return std::clamp(row, 0, Self().Rows() - 1); }
+    int ClampCol(int col) const { return std::clamp(col, 0, Self().Cols() - 1); }
+
+    // nullptr for empty or out-of-range tiles
+    Plant *PlantAt(int row, int col) const {
+        return InBounds(row, col) ? Self().occupancy[TileIndex(row, col)] : nullptr;
+    }
+
+    void SetPlantAt(int row, int col, Plant *plant) { Self().occupancy[TileIndex(row, col)] = plant; }
+
+    void ClearTiles() { std::fill(Self().occupancy.begin(), Self().occupancy.end(), nullptr); }
+
+private:
+    const Derived &Self() const { return static_cast<const Derived &>(*this); }
+    Derived &Self() { return static_cast<Derived &>(*this); }
+};
+
+template <int RowCount, int ColCount>
+class Board : public BoardTiles<Board<RowCount, ColCount> > {
+public:
+    std::array<Lane, RowCount> lanes;
+    std::array<Plant *, RowCount * ColCount> occupancy; // Row-major, nullptr for an empty tile
+
+    explicit Board(size_t projectileLaneLimit)
+        : lanes(MakeLanes(projectileLaneLimit, std::make_index_sequence<RowCount>())) {
+        occupancy.fill(nullptr);
+    }
+
+    static constexpr int Rows() { return RowCount; }
+    static constexpr int Cols() { return ColCount; }
+
+private:
+    // Lane has no default constructor, so the array is built from one Lane(limit) per row
+    template <size_t... Row>
+    static std::array<Lane, RowCount> MakeLanes(size_t projectileLaneLimit, std::index_sequence<Row...>) {
+        return {{((void) Row, Lane(projectileLaneLimit))...}};
+    }
+};
+
+class DynamicBoard : public BoardTiles<DynamicBoard> {
+public:
+    std::vector<Lane> lanes;
+    std::vector<Plant *> occupancy; // Row-major, nullptr for an empty tile
+
+    DynamicBoard(int rows, int cols, size_t projectileLaneLimit);
+
+    int Rows() const { return rows; }
+    int Cols() const { return cols; }
+
+private:
+    int rows;
+    int cols;
+};
+
+// The standard lawn; any other size gets a DynamicBoard
+using StandardBoard = Board<STANDARD_BOARD_ROWS, STANDARD_BOARD_COLS>;
+
+// The lanes of a board in row order, whichever kind of board holds them
+struct LaneSpan {
+    Lane *first = nullptr;
+    size_t count = 0;
+
+    Lane *begin() const { return first; }
+    Lane *end() const { return first + count; }
+    size_t size() const { return count; }
+    Lane &operator[](size_t row) const { return first[row]; }
+};
+
+//----------------------------------------------------------------------------------
+// World Class
+//----------------------------------------------------------------------------------
+// The lawn, stored as board.rows lane buckets indexed by row, plus a
+// board.rows x board.cols occupancy table pointing at the plant on each tile.
+//
+// The storage is a StandardBoard for the 5x9 lawn and a DynamicBoard for anything else.
+// Every tile lookup, bounds check and row/column clamp (placement, bites, blasts) goes
+// through VisitBoard(), so on the standard lawn they run against compile-time sizes, as
+// do the per-tick loops over the whole lawn. Only a lane picked by row goes through the
+// lanes view, which costs the same for both.
+class World {
+public:
+    BoardConfig board; // Fixed for the lifetime of the World
+    LaneSpan lanes; // Views into the board storage (owned by the World)
+
+    // Each lane's projectile store may grow to board.MaxLaneProjectiles()
+    explicit World(const BoardConfig &board = BoardConfig());
+
+    // lanes points into the World itself
+    World(const World &) = delete;
+    World &operator=(const World &) = delete;
+
+    // Calls fn with the board storage as its concrete type (StandardBoard & or DynamicBoard &).
+    // fn is instantiated for both, so write it as a generic lambda.
+    template <typename Fn>
+    decltype(auto) VisitBoard(Fn &&fn) { return std::visit(std::forward<Fn>(fn), storage); }
+
+    template <typename Fn>
+    decltype(auto) VisitBoard(Fn &&fn) const { return std::visit(std::forward<Fn>(fn), storage); }
+
+    bool HasStandardBoard() const { return std::holds_alternative<StandardBoard>(storage); }
+
+    // Empties every lane and tile (the lanes themselves stay)
+    void Clear();
+
+    // Adds a projectile to the given lane. Returns false if the store is full and the shot was dropped.
+    bool SpawnProjectile(int row, float x, float y, float vx, int damage, ProjectileType type) {
+        return lanes[row].projectiles.Spawn(x, y, vx, damage, type);
+    }
+
+    // Queues a zombie hit on the damage queue of the lane that caused it
+    void QueueDamage(int sourceRow, Zombie *target, int amount) { lanes[sourceRow].damage.Damage(target, amount); }
+
+    // Entities never call PlaySound themselves; the Simulation plays these after the tick
+    void QueueSound(int row, Sound sound) { lanes[row].sounds.push_back(sound); }
+
+    // Removes everything marked inactive during the tick and frees the tiles of dead plants.
+    // Entities are only ever deactivated mid-tick; this is the one place they are erased.
+    void Compact();
+
+    // Compact() for a single lane. Only touches that lane and its row of the occupancy table.
+    void CompactLane(int row);
+
+    Lane &GetLane(int row) { return lanes[row]; }
+    const Lane &GetLane(int row) const { return lanes[row]; }
+
+    int Rows() const { return board.rows; }
+    int Cols() const { return board.cols; }
+
+    bool InBounds(int row, int col) const {
+        return VisitBoard([row, col](const auto &lawn) { return lawn.InBounds(row, col); });
+    }
+
+    // O(1) tile lookups. PlantAt returns nullptr for empty or out-of-range tiles.
+    Plant *PlantAt(int row, int col) const {
+        return VisitBoard([row, col](const auto &lawn) { return lawn.PlantAt(row, col); });
+    }
+
+    void SetPlantAt(int row, int col, Plant *plant) {
+        VisitBoard([row, col, plant](auto &lawn) { lawn.SetPlantAt(row, col, plant); });
+    }
+
+    // The leftmost active zombie in this row whose rect.x is past x, or nullptr
+    Zombie *FirstZombieAhead(int row, float x) const;
+
+    // True if an active zombie in this row is to the right of x (the Peashooter family's target check)
+    bool HasZombieAhead(int row, float x) const { return FirstZombieAhead(row, x) != nullptr; }
+
+    // Area query: calls fn(Zombie &) for every active zombie in rows firstRow..lastRow (clamped
+    // to the board) whose rect overlaps minX..maxX horizontally. Each lane is entered with a
+    // binary search on its sorted list, so zombies outside the range are never touched.
+    // Returns the number of zombies visited.
+    template <typename Fn>
+    int ForEachZombieInRange(int firstRow, int lastRow, float minX, float maxX, Fn &&fn) const {
+        return VisitBoard([&](const auto &lawn) {
+            int visited = 0;
+            if (lastRow < 0 || firstRow >= lawn.Rows()) return visited;
+            for (int row = lawn.ClampRow(firstRow); row <= lawn.ClampRow(lastRow); ++row) {
+                const Lane &lane = lawn.lanes[row];
+                for (size_t i = lane.FirstZombieFrom(minX - lane.maxZombieWidth); i < lane.zombies.size(); ++i) {
+                    Zombie *zombie = lane.zombies[i];
+                    if (zombie->rect.x >= maxX) break;
+                    if (zombie->active && zombie->rect.x + zombie->rect.width > minX) {
+                        fn(*zombie);
+                        ++visited;
+                    }
+                }
+            }
+            return visited;
+        });
+    }
+
+    // Area query in tiles: every active zombie within rowRadius lanes and colRadius columns
+    // of the given tile, with the columns clamped to the lawn (a Cherry Bomb is (1, 1))
+    template <typename Fn>
+    int ForEachZombieAroundTile(int row, int col, int rowRadius, int colRadius, Fn &&fn) const {
+        int firstCol = VisitBoard([col, colRadius](const auto &lawn) { return lawn.ClampCol(col - colRadius); });
+        int lastCol = VisitBoard([col, colRadius](const auto &lawn) { return lawn.ClampCol(col + colRadius); });
+        return ForEachZombieInRange(row - rowRadius, row + rowRadius, board.TileX(firstCol), board.TileX(lastCol + 1), fn);
+    }
+
+    // The active plant in this row whose rect overlaps the given rect, checked left to right.
+    // Only the few tiles under the rect are looked at, never the whole lane.
+    Plant *PlantTouching(int row, Rectangle rect) const;
+
+    size_t PlantCount() const;
+    size_t ZombieCount() const;
+    size_t ProjectileCount() const;
+    size_t DroppedProjectileCount() const; // Shots lost to full lane stores since the World was built
+
+private:
+    std::variant<StandardBoard, DynamicBoard> storage;
+};
+
+#endif // WORLD_H
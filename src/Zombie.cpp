@@ -2,7 +2,9 @@
 
 #include "Zombie.h"
 #include "Plant.h" // Needed to interact with Plant objects
+#include "World.h" // Occupancy lookups
 #include "GameConstants.h" // Include game_constants.h for all constants
+#include "MathUtils.h"
 #include <iostream>
 #include <cmath> // For std::pow if you use exponential scaling
 
@@ -13,24 +15,19 @@
 //----------------------------------------------------------------------------------
 // Base Zombie Implementation
 //----------------------------------------------------------------------------------
-Zombie::Zombie(Rectangle rect, int baseHealth, float baseSpeed, Color color, Texture2D tex, int row,
-               int numFrames, float frameSpeed, int numSpriteRows, int currentRowIndex,
+Zombie::Zombie(Rectangle rect, int baseHealth, float baseSpeed, Color color, const AnimationSet &animations, int row,
                int attackDamagePerBite_param, float biteRate_param, int scoreValue_param, int level)
     // Initialize members in the SAME ORDER as they are declared in zombie.h to avoid -Wreorder
     : rect(rect),
+      prevRect(rect),
       health(static_cast<int>(baseHealth * (1.0f + (level - 1) * 0.2f))), // Apply level scaling to health
+      pendingDamage(0),
       speed(baseSpeed + (level - 1) * 2.0f), // Example: Speed scales by 2.0f per level
       active(true),
       color(color),
-      texture(tex),
-      sourceRect({0, 0, (float)tex.width / numFrames, (float)tex.height / numSpriteRows}), // Calculated here
-      currentFrame(0),
-      frameTimer(0.0f),
-      frameSpeed(frameSpeed),
-      numFrames(numFrames),
-      numSpriteRows(numSpriteRows),
-      currentRowIndex(currentRowIndex),
-      row(row), // Reordered to match header (if it was after animation params)
+      animations(&animations),
+      animation(), // Starts on ZOMBIE_CLIP_WALK
+      row(row),
       isAttacking(false),
       biteTimer(0.0f),
       biteRate(biteRate_param),
@@ -45,13 +42,12 @@ Zombie::Zombie(Rectangle rect, int baseHealth, float baseSpeed, Color color, Tex
     if (health < 1) health = 1;
     // Ensure speed doesn't go below zero if you have very high levels
     if (speed < 0.0f) speed = 0.0f;
-
-    // No need to set sourceRect again here, it's done in the initializer list
 }
 
-void Zombie::Draw() const {
+void Zombie::Draw(RenderQueue &queue, float alpha) const {
     if (active) {
-        DrawTexturePro(texture, sourceRect, rect, {0, 0}, 0, WHITE);
+        queue.Push(RenderLayer::ZOMBIES, row, animations->texture, animation.FrameRect(*animations),
+                   LerpRect(prevRect, rect, alpha));
         // Optional: Draw health bar for debugging
         // You would need to pass an initial/max health value to the Zombie class
         // to correctly draw a health bar, or calculate it here based on level.
@@ -61,27 +57,12 @@ void Zombie::Draw() const {
     }
 }
 
-void Zombie::UpdateSourceRect() {
-    float singleFrameWidth = (float)texture.width / numFrames;
-    float singleFrameHeight = (float)texture.height / numSpriteRows;
-
-    sourceRect.x = currentFrame * singleFrameWidth;
-    sourceRect.y = currentRowIndex * singleFrameHeight;
-    sourceRect.width = singleFrameWidth;
-    sourceRect.height = singleFrameHeight;
-}
-
 void Zombie::AttackPlant(Plant* plant, float deltaTime) {
     isAttacking = true;
     biteTimer += deltaTime;
 
     // Animation update during attack
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        UpdateSourceRect();
-    }
+    animation.Advance(*animations, deltaTime);
 
     if (biteTimer >= biteRate) {
         biteTimer = 0.0f;
@@ -103,12 +84,9 @@ void Zombie::ApplySlowEffect() {
 //----------------------------------------------------------------------------------
 // RegularZombie Implementation
 //----------------------------------------------------------------------------------
-RegularZombie::RegularZombie(Rectangle rect, int row, Texture2D tex, int level)
+RegularZombie::RegularZombie(Rectangle rect, int row, const AnimationSet &animations, int level)
     : Zombie(rect,
-             REGULAR_ZOMBIE_HEALTH, REGULAR_ZOMBIE_SPEED, RED, tex, row,
-             REGULAR_ZOMBIE_WALKING_NUM_FRAMES, REGULAR_ZOMBIE_WALKING_FRAME_SPEED,
-             REGULAR_ZOMBIE_TOTAL_SPRITE_ROWS,
-             0, // currentRowIndex for walking (assuming row 0 for walking animation)
+             REGULAR_ZOMBIE_HEALTH, REGULAR_ZOMBIE_SPEED, RED, animations, row,
              ZOMBIE_DAMAGE_PER_BITE, ZOMBIE_BITE_RATE, // Base bite damage and rate
              REGULAR_ZOMBIE_SCORE_VALUE, // Base score value of 100 is passed here
              level) // Pass the 'level' here!
@@ -116,7 +94,7 @@ RegularZombie::RegularZombie(Rectangle rect, int row, Texture2D tex, int level)
     // No specific initialization needed here, base constructor handles health calculation and scaling
 }
 
-void RegularZombie::Update(float deltaTime, std::vector<std::unique_ptr<Plant>>& plants) {
+void RegularZombie::Update(float deltaTime, World &world) {
     if (!active) return;
 
     // --- SLOW EFFECT LOGIC (MUST BE INCLUDED IN EACH DERIVED UPDATE) ---
@@ -132,37 +110,24 @@ void RegularZombie::Update(float deltaTime, std::vector<std::unique_ptr<Plant>>&
     bool wasAttacking = isAttacking;
     isAttacking = false; // Reset attack state for current frame
 
-    // Check for collision with plants in the same row
-    for (auto& plant : plants) {
-        if (plant->active && plant->row == this->row && CheckCollisionRecs(this->rect, plant->rect)) {
-            AttackPlant(plant.get(), deltaTime);
-            isAttacking = true; // Set to true if collision and attack happened
-            break; // Stop checking after first collision, attack only one plant at a time
-        }
+    // Check for collision with a plant on the tiles under this zombie (attack only one at a time)
+    Plant* plant = world.PlantTouching(this->row, this->rect);
+    if (plant) {
+        AttackPlant(plant, deltaTime);
+        isAttacking = true; // Set to true if collision and attack happened
     }
 
     // Animation state transition logic for Regular Zombie
     if (isAttacking) {
         // If we just started attacking OR we were walking previously, switch to eating animation
-        // currentRowIndex 1 is assumed for eating, 0 for walking
-        if (!wasAttacking || this->currentRowIndex != 1) {
-            this->currentRowIndex = 1;
-            this->numFrames = REGULAR_ZOMBIE_EATING_NUM_FRAMES;
-            this->frameSpeed = REGULAR_ZOMBIE_EATING_FRAME_SPEED;
-            this->currentFrame = 0; // Reset frame to start of eating animation
-            this->frameTimer = 0.0f;
-            UpdateSourceRect(); // Update sourceRect immediately on state change
+        if (!wasAttacking || animation.clip != ZOMBIE_CLIP_EAT) {
+            animation.Play(ZOMBIE_CLIP_EAT);
         }
         // Zombie doesn't move forward while attacking
     } else { // Not attacking (i.e., moving)
         // If we just stopped attacking OR we were eating previously, switch to walking animation
-        if (wasAttacking || this->currentRowIndex != 0) {
-            this->currentRowIndex = 0;
-            this->numFrames = REGULAR_ZOMBIE_WALKING_NUM_FRAMES;
-            this->frameSpeed = REGULAR_ZOMBIE_WALKING_FRAME_SPEED;
-            this->currentFrame = 0; // Reset frame to start of walking animation
-            this->frameTimer = 0.0f;
-            UpdateSourceRect(); // Update sourceRect immediately on state change
+        if (wasAttacking || animation.clip != ZOMBIE_CLIP_WALK) {
+            animation.Play(ZOMBIE_CLIP_WALK);
         }
 
         // Only move if not attacking (and apply current speed, whether normal or slowed)
@@ -170,33 +135,26 @@ void RegularZombie::Update(float deltaTime, std::vector<std::unique_ptr<Plant>>&
     }
 
     // Update animation frame (applies to both walking and eating states)
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        UpdateSourceRect();
-    }
+    animation.Advance(*animations, deltaTime);
 }
 
 //----------------------------------------------------------------------------------
 // JumpingZombie Implementation
 //----------------------------------------------------------------------------------
-JumpingZombie::JumpingZombie(Rectangle rect, int row, Texture2D tex, int level)
+JumpingZombie::JumpingZombie(Rectangle rect, int row, const AnimationSet &animations, int level)
     : Zombie(rect,
-             JUMPING_ZOMBIE_HEALTH, JUMPING_ZOMBIE_SPEED, BLUE, tex, row, // BLUE for visual distinction
-             JUMPING_ZOMBIE_NUM_FRAMES, JUMPING_ZOMBIE_FRAME_SPEED,
-             JUMPING_ZOMBIE_TOTAL_SPRITE_ROWS,
-             0, // Assuming initial currentRowIndex is 0 for jumping zombie
+             JUMPING_ZOMBIE_HEALTH, JUMPING_ZOMBIE_SPEED, BLUE, animations, row, // BLUE for visual distinction
              ZOMBIE_DAMAGE_PER_BITE, ZOMBIE_BITE_RATE, // Base bite damage and rate (or specific jumping zombie ones)
              JUMPING_ZOMBIE_SCORE_VALUE, // Base score value for jumping zombie
              level), // Pass the 'level' here!
       // Initialize JumpingZombie specific members AFTER the base class constructor
-      isJumping(false), jumpTimer(0.0f), jumpDuration(0.8f), initialY(rect.y), jumpPeakHeight(TILE_SIZE * 0.75f)
+      isJumping(false), jumpTimer(0.0f), jumpDuration(0.8f), initialY(rect.y),
+      jumpPeakHeight(rect.height * 0.75f / 1.4f) // 3/4 of a tile (zombies are 1.4 tiles tall)
 {
     // No specific initialization needed here, base constructor handles health calculation
 }
 
-void JumpingZombie::Update(float deltaTime, std::vector<std::unique_ptr<Plant>>& plants) {
+void JumpingZombie::Update(float deltaTime, World &world) {
     if (!active) return;
 
     // --- SLOW EFFECT LOGIC (MUST BE INCLUDED IN EACH DERIVED UPDATE) ---
@@ -211,13 +169,7 @@ void JumpingZombie::Update(float deltaTime, std::vector<std::unique_ptr<Plant>>&
 
     isAttacking = false; // Reset attack state for current frame
 
-    Plant* collidedPlant = nullptr;
-    for (auto& plant : plants) {
-        if (plant->active && plant->row == this->row && CheckCollisionRecs(this->rect, plant->rect)) {
-            collidedPlant = plant.get();
-            break; // Found a plant to interact with
-        }
-    }
+    Plant* collidedPlant = world.PlantTouching(this->row, this->rect);
 
     if (collidedPlant) {
         // Jumping Zombie logic: Jump over specific plants (Cherry Bomb, Wall-nut), attack others
@@ -261,10 +213,5 @@ void JumpingZombie::Update(float deltaTime, std::vector<std::unique_ptr<Plant>>&
     }
 
     // Update animation frame (for both moving/jumping and attacking states)
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        UpdateSourceRect();
-    }
+    animation.Advance(*animations, deltaTime);
 }
\ No newline at end of file
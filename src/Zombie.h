@@ -6,9 +6,13 @@
 #include <vector>
 #include <memory> // For std::unique_ptr
 #include "GameConstants.h"
+#include "Sprite.h"
+#include "RenderQueue.h"
+#include "Animation.h"
 
-// Forward declaration for Plant
+// Forward declarations
 class Plant;
+class World;
 
 // Enum to differentiate zombie types
 enum class ZombieType {
@@ -22,18 +26,14 @@ enum class ZombieType {
 class Zombie {
 public:
     Rectangle rect;
-    int health;
+    Rectangle prevRect; // rect at the start of the current simulation tick, for render interpolation
+    int health; // Only DamageQueue::Commit changes it; damage a zombie with World::QueueDamage
+    int pendingDamage; // Damage queued this tick and not yet committed (see DamageQueue::MarkPending)
     float speed;
     bool active;
     Color color; // Fallback color, will be overridden by texture
-    Texture2D texture; // Sprite sheet for the zombie
-    Rectangle sourceRect; // Current frame in the sprite sheet
-    int currentFrame;
-    float frameTimer;
-    float frameSpeed;
-    int numFrames; // Total horizontal frames in *one* row
-    int numSpriteRows; // Total number of rows in the sprite sheet
-    int currentRowIndex; // Which row to animate from (0 for top, 1 for next, etc.)
+    const AnimationSet *animations; // Frame tables for this zombie type, owned by the Simulation
+    AnimationState animation; // Current clip (ZOMBIE_CLIP_*) and frame
     int row;
     bool isAttacking; // True if currently eating a plant
     float biteTimer;
@@ -45,29 +45,19 @@ public:
     float slowTimer;
     float originalSpeed;
 
-    Zombie(Rectangle rect, int baseHealth, float baseSpeed, Color color, Texture2D tex, int row,
-           int numFrames, float frameSpeed, int numSpriteRows, int currentRowIndex,
+    Zombie(Rectangle rect, int baseHealth, float baseSpeed, Color color, const AnimationSet &animations, int row,
            int attackDamagePerBite, float biteRate, int scoreValue, int level);
 
     virtual ~Zombie() = default;
 
-    virtual void Update(float deltaTime, std::vector<std::unique_ptr<Plant> > &plants) = 0;
+    virtual void Update(float deltaTime, World &world) = 0;
 
-    virtual void Draw() const;
+    virtual void Draw(RenderQueue &queue, float alpha = 1.0f) const;
 
     virtual ZombieType GetType() const = 0;
 
-    void TakeDamage(int damage) {
-        health -= damage;
-        if (health <= 0) {
-            active = false;
-        }
-    }
-
     void AttackPlant(Plant *plant, float deltaTime);
 
-    void UpdateSourceRect();
-
     void ApplySlowEffect();
 };
 
@@ -76,17 +66,17 @@ public:
 //----------------------------------------------------------------------------------
 
 // RegularZombie
-class RegularZombie : public Zombie {
+class RegularZombie final : public Zombie {
 public:
-    RegularZombie(Rectangle rect, int row, Texture2D tex, int level);
+    RegularZombie(Rectangle rect, int row, const AnimationSet &animations, int level);
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Plant> > &plants) override;
+    void Update(float deltaTime, World &world) override;
 
     ZombieType GetType() const override { return ZombieType::REGULAR; }
 };
 
 // JumpingZombie
-class JumpingZombie : public Zombie {
+class JumpingZombie final : public Zombie {
 private:
     bool isJumping;
     float jumpTimer;
@@ -95,9 +85,9 @@ private:
     float jumpPeakHeight;
 
 public:
-    JumpingZombie(Rectangle rect, int row, Texture2D tex, int level);
+    JumpingZombie(Rectangle rect, int row, const AnimationSet &animations, int level);
 
-    void Update(float deltaTime, std::vector<std::unique_ptr<Plant> > &plants) override;
+    void Update(float deltaTime, World &world) override;
 
     ZombieType GetType() const override { return ZombieType::JUMPING; }
 };
@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
 
 // Include headers
 #include "GameState.h"
@@ -12,130 +16,466 @@
 #include "Zombie.h"
 #include "GameConstants.h"
 #include "LawnMower.h"
-
-// Game Constants
-const int SCREEN_WIDTH = 1280;
-const int SCREEN_HEIGHT = 720;
-const int GRID_ROWS = 5;
-const int GRID_COLS = 9;
-const int ORIGINAL_TILE_SIZE = 80;
-const int TILE_SIZE = static_cast<int>(ORIGINAL_TILE_SIZE * 1.2f);
-const int Y_OFFSET = 80;
-const int UI_PANEL_HEIGHT = 120;
+#include "Simulation.h"
+#include "MathUtils.h"
+#include "StressTest.h"
+#include "JobSystem.h"
+#include "BoardConfig.h"
+#include "TextureAtlas.h"
+#include "RenderQueue.h"
+#include "rlgl.h"
+
+// UI Constants (grid layout lives in GameConstants.cpp)
 const int UI_PANEL_Y = 0;
 const int UI_PANEL_PADDING = 10;
-const int GRID_START_X = 90;
-const int GRID_START_Y = UI_PANEL_HEIGHT + Y_OFFSET;
 const int PAUSE_BUTTON_SIZE = 60;
 const int PLANT_ICON_SIZE = 70;
 const int PLANT_ICON_SPACING = 20;
 
 // Global Variables
-int sunCurrency = 50;
 PlantType currentSelectedPlantType = PlantType::PEASHOOTER;
-int score = 0;
-int currentLevel = 1;
-int targetScore = 1000;
 
 Music backgroundMusic;
 
-int CalculateTargetScore(int level) {
-    return level == 1 ? 1000 : 1000 + (level - 1) * 3000;
+// A file to decode on a worker and the variable its uploaded asset ends up in
+struct TextureFile {
+    const char *path;
+    Texture2D *texture;
+    Image image;
+};
+
+// Same, for a gameplay sprite that gets packed into the atlas
+struct SpriteFile {
+    const char *path;
+    Sprite *sprite;
+    Image image;
+};
+
+struct SoundFile {
+    const char *path;
+    Sound *sound;
+    Wave wave;
+};
+
+// Decoding PNG/MP3 data is pure CPU work, so every file is decoded as a job in parallel.
+// Creating the GPU textures and audio buffers has to stay on the main thread, so that
+// part runs here once all the decoding is done.
+//
+// The sprites are packed into atlas. If useAtlas is off (or they do not fit) each sprite
+// gets a texture of its own instead, and those textures are added to looseTextures.
+void LoadAssets(JobSystem &jobs, std::vector<TextureFile> &textures, std::vector<SpriteFile> &sprites,
+                std::vector<SoundFile> &sounds, bool useAtlas, TextureAtlas &atlas,
+                std::vector<Texture2D> &looseTextures) {
+    TaskGroup decoding;
+    for (auto &file: textures) {
+        jobs.Run(decoding, [&file] { file.image = LoadImage(file.path); });
+    }
+    for (auto &file: sprites) {
+        jobs.Run(decoding, [&file] { file.image = LoadImage(file.path); });
+    }
+    for (auto &file: sounds) {
+        jobs.Run(decoding, [&file] { file.wave = LoadWave(file.path); });
+    }
+    jobs.Wait(decoding);
+
+    for (auto &file: textures) {
+        *file.texture = LoadTextureFromImage(file.image);
+        UnloadImage(file.image);
+    }
+
+    std::vector<Image> spriteImages;
+    for (const auto &file: sprites) spriteImages.push_back(file.image);
+    std::vector<Sprite> packed;
+    if (useAtlas && atlas.Build(spriteImages, packed)) {
+        for (size_t i = 0; i < sprites.size(); ++i) *sprites[i].sprite = packed[i];
+    } else {
+        for (auto &file: sprites) {
+            Texture2D texture = LoadTextureFromImage(file.image);
+            looseTextures.push_back(texture);
+            *file.sprite = SpriteFromTexture(texture);
+        }
+    }
+    for (auto &file: sprites) UnloadImage(file.image);
+
+    for (auto &file: sounds) {
+        *file.sound = LoadSoundFromWave(file.wave);
+        UnloadWave(file.wave);
+    }
 }
 
-void ResetGame(std::vector<std::unique_ptr<Plant> > &plants,
-               std::vector<std::unique_ptr<Zombie> > &zombies,
-               std::vector<std::unique_ptr<Projectile> > &projectiles,
-               std::vector<std::unique_ptr<LawnMower> > &lawnmowers,
-               Texture2D lawnmowerTex,
-               Texture2D regularZombieTex,
-               Texture2D jumpingZombieTex,
-               float &zombieSpawnTimer,
-               float &zombieSpawnRate,
-               int &sunCurrency_ref,
-               int &score_ref,
-               PlantType &currentSelectedPlantType_ref,
-               int levelToSet) {
-    plants.clear();
-    zombies.clear();
-    projectiles.clear();
-    lawnmowers.clear();
-
-    for (int i = 0; i < GRID_ROWS; ++i) {
-        Rectangle mowerRect = {
-            (float) GRID_START_X - TILE_SIZE,
-            (float) GRID_START_Y + i * TILE_SIZE,
-            TILE_SIZE / 2.0f * 1.8f,
-            TILE_SIZE / 2.0f * 1.8f
-        };
-        lawnmowers.push_back(std::make_unique<LawnMower>(mowerRect, i, lawnmowerTex));
+// Draws a sprite PLANT_ICON_SIZE wide at the top-left of rect, keeping its aspect ratio
+void DrawIcon(const Sprite &sprite, Rectangle rect) {
+    float scale = PLANT_ICON_SIZE / sprite.region.width;
+    DrawSprite(sprite, {rect.x, rect.y, sprite.region.width * scale, sprite.region.height * scale}, WHITE);
+}
+
+//----------------------------------------------------------------------------------
+// Board Camera
+//----------------------------------------------------------------------------------
+// The lawn is drawn through a Camera2D so boards bigger than the window can be scrolled.
+// The view can travel from the window's usual position out to where the zombies walk in
+// and down to the bottom row, so on the standard lawn it never moves.
+void ScrollBoardCamera(Camera2D &camera, const BoardConfig &board, float deltaTime) {
+    const float keyScrollSpeed = 1200.0f; // Pixels per second
+    const float wheelScrollStep = 2.0f * board.tileSize;
+
+    Vector2 scroll = {0.0f, 0.0f};
+    if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) scroll.x -= keyScrollSpeed * deltaTime;
+    if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) scroll.x += keyScrollSpeed * deltaTime;
+    if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) scroll.y -= keyScrollSpeed * deltaTime;
+    if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) scroll.y += keyScrollSpeed * deltaTime;
+    scroll.x -= GetMouseWheelMove() * wheelScrollStep; // Wheel up pans back towards the house
+
+    float maxX = std::max(0.0f, board.fieldRight - SCREEN_WIDTH);
+    float maxY = std::max(0.0f, board.Bottom() - BoardConfig().Bottom());
+    camera.target.x = std::clamp(camera.target.x + scroll.x, 0.0f, maxX);
+    camera.target.y = std::clamp(camera.target.y + scroll.y, 0.0f, maxY);
+}
+
+// The tiles inside the camera's view, widened by margin tiles on every side and clamped
+// to the board. Entities overhang their tile, so callers pass a margin of at least 1.
+struct TileRange {
+    int firstRow, lastRow;
+    int firstCol, lastCol;
+};
+
+TileRange VisibleTiles(const BoardConfig &board, const Camera2D &camera, int margin) {
+    TileRange range;
+    range.firstRow = std::max(board.RowAt(camera.target.y) - margin, 0);
+    range.lastRow = std::min(board.RowAt(camera.target.y + SCREEN_HEIGHT) + margin, board.rows - 1);
+    range.firstCol = std::max(board.ColumnAt(camera.target.x) - margin, 0);
+    range.lastCol = std::min(board.ColumnAt(camera.target.x + SCREEN_WIDTH) + margin, board.cols - 1);
+    return range;
+}
+
+// The grass texture is a picture of one standard 5x9 lawn, so bigger boards repeat it in
+// 5x9 blocks (cut short along the last block row and column). Only blocks in view are drawn.
+void DrawLawn(Texture2D grassTex, const BoardConfig &board, const Camera2D &camera) {
+    TileRange visible = VisibleTiles(board, camera, 0);
+    for (int blockRow = visible.firstRow / GRID_ROWS; blockRow <= visible.lastRow / GRID_ROWS; ++blockRow) {
+        for (int blockCol = visible.firstCol / GRID_COLS; blockCol <= visible.lastCol / GRID_COLS; ++blockCol) {
+            int rows = std::min(GRID_ROWS, board.rows - blockRow * GRID_ROWS);
+            int cols = std::min(GRID_COLS, board.cols - blockCol * GRID_COLS);
+            DrawTexturePro(grassTex,
+                           (Rectangle){
+                               0, 0,
+                               (float) grassTex.width * cols / GRID_COLS, (float) grassTex.height * rows / GRID_ROWS
+                           },
+                           (Rectangle){
+                               board.TileX(blockCol * GRID_COLS), board.TileY(blockRow * GRID_ROWS),
+                               (float) (cols * board.tileSize), (float) (rows * board.tileSize)
+                           },
+                           (Vector2){0, 0}, 0.0f, WHITE);
+        }
     }
+}
 
-    zombieSpawnTimer = 0.0f;
-    sunCurrency_ref = 50;
-    score_ref = 0;
-    currentSelectedPlantType_ref = PlantType::PEASHOOTER;
-    currentLevel = levelToSet;
-    targetScore = CalculateTargetScore(currentLevel);
-
-    zombieSpawnRate = 5.0f - (currentLevel - 1) * 0.4f;
-    if (zombieSpawnRate < 1.0f) zombieSpawnRate = 1.0f;
-
-    int initialZombies = currentLevel * 2;
-    if (initialZombies > 10) initialZombies = 10;
-
-    for (int i = 0; i < initialZombies; ++i) {
-        int spawnRow = GetRandomValue(0, GRID_ROWS - 1);
-        Rectangle zombieRect = {
-            (float) SCREEN_WIDTH + i * TILE_SIZE,
-            (float) GRID_START_Y + spawnRow * TILE_SIZE + (TILE_SIZE / 4.0f),
-            TILE_SIZE / 2.0f * 2.8f,
-            TILE_SIZE / 2.0f * 2.8f
-        };
+// Copies a render texture to the screen at position, 1:1 and with blending off. The cached
+// layers are opaque, so there is nothing to blend with, and skipping it saves the GPU a
+// read of every pixel underneath.
+void BlitRenderTexture(const RenderTexture2D &target, Vector2 position) {
+    rlDrawRenderBatchActive(); // Whatever was queued before still gets blended
+    rlDisableColorBlend();
+    // Render textures come out upside down, hence the negative source height
+    DrawTextureRec(target.texture,
+                   (Rectangle){0, 0, (float) target.texture.width, (float) -target.texture.height},
+                   position, WHITE);
+    rlDrawRenderBatchActive();
+    rlEnableColorBlend();
+}
 
-        std::unique_ptr<Zombie> newZombie;
-        if (GetRandomValue(0, 1) == 0) {
-            newZombie = std::make_unique<RegularZombie>(zombieRect, spawnRow, regularZombieTex, currentLevel);
-        } else {
-            newZombie = std::make_unique<JumpingZombie>(zombieRect, spawnRow, jumpingZombieTex, currentLevel);
+//----------------------------------------------------------------------------------
+// Background Cache
+//----------------------------------------------------------------------------------
+// Which static picture the background cache holds
+enum class BackgroundKind {
+    NONE,
+    MAIN_MENU,
+    LAWN, // The level-up screen shows the lawn without the UI panel
+    LAWN_AND_PANEL
+};
+
+// The frame's backdrop, drawn into a window-sized render texture and copied 1:1 every
+// frame. The large menu and grass images are only scaled and sampled again when the
+// picture changes, the window is resized, or the camera moves (which only happens on
+// boards bigger than the window).
+struct BackgroundCache {
+    RenderTexture2D target = {};
+    BackgroundKind kind = BackgroundKind::NONE;
+    Vector2 cameraTarget = {};
+    int rebuilds = 0; // Shown with --render-stats
+};
+
+// Rebuilds the backdrop if needed. Call it before BeginDrawing(): it switches the render target.
+void UpdateBackgroundCache(BackgroundCache &background, BackgroundKind kind, const Camera2D &camera,
+                           const BoardConfig &board, Texture2D mainMenuTex, Texture2D grassTex) {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    if (background.target.id == 0 ||
+        background.target.texture.width != width || background.target.texture.height != height) {
+        if (background.target.id > 0) {
+            UnloadRenderTexture(background.target);
+        }
+        background.target = LoadRenderTexture(width, height);
+        background.kind = BackgroundKind::NONE;
+    }
+
+    bool cameraMoved = background.cameraTarget.x != camera.target.x || background.cameraTarget.y != camera.target.y;
+    if (background.kind == kind && (kind == BackgroundKind::MAIN_MENU || !cameraMoved)) return;
+
+    BeginTextureMode(background.target);
+    ClearBackground(DARKGRAY);
+    if (kind == BackgroundKind::MAIN_MENU) {
+        DrawTexturePro(mainMenuTex,
+                       (Rectangle){0, 0, (float) mainMenuTex.width, (float) mainMenuTex.height},
+                       (Rectangle){0, 0, (float) SCREEN_WIDTH, (float) SCREEN_HEIGHT},
+                       (Vector2){0, 0}, 0.0f, WHITE);
+    } else {
+        BeginMode2D(camera);
+        DrawLawn(grassTex, board, camera);
+        EndMode2D();
+        if (kind == BackgroundKind::LAWN_AND_PANEL) {
+            DrawRectangle(0, UI_PANEL_Y, SCREEN_WIDTH, UI_PANEL_HEIGHT, CLITERAL(Color){50, 50, 50, 255});
+        }
+    }
+    EndTextureMode();
+
+    background.kind = kind;
+    background.cameraTarget = camera.target;
+    background.rebuilds++;
+}
+
+void DrawBackgroundCache(const BackgroundCache &background) {
+    BlitRenderTexture(background.target, (Vector2){0, 0});
+}
+
+void UnloadBackgroundCache(BackgroundCache &background) {
+    if (background.target.id > 0) {
+        UnloadRenderTexture(background.target);
+    }
+    background = BackgroundCache();
+}
+
+//----------------------------------------------------------------------------------
+// HUD Cache
+//----------------------------------------------------------------------------------
+// Everything the gameplay HUD shows that can change during a game
+struct HudValues {
+    int sunCurrency;
+    int score;
+    int level;
+    int targetScore;
+    PlantType selected;
+
+    bool operator==(const HudValues &other) const {
+        return sunCurrency == other.sunCurrency && score == other.score && level == other.level &&
+               targetScore == other.targetScore && selected == other.selected;
+    }
+
+    bool operator!=(const HudValues &other) const { return !(*this == other); }
+};
+
+// One plant button on the HUD. rect is in screen space and is also what clicks are tested against.
+struct HudButton {
+    PlantType type; // Selected when the button is clicked with at least cost sun in the bank
+    const char *name;
+    int cost;
+    Sprite icon;
+    Rectangle rect;
+};
+
+// The button under point, or nullptr
+const HudButton *HudButtonAt(const std::vector<HudButton> &buttons, Vector2 point) {
+    for (const HudButton &button: buttons) {
+        if (CheckCollisionPointRec(point, button.rect)) return &button;
+    }
+    return nullptr;
+}
+
+// The gameplay HUD panel, drawn into a texture the size of the panel and blitted every
+// frame. The texts, icons and pause button are only redrawn into it when the HudValues
+// change, so most frames cost one textured quad and no string building.
+struct HudCache {
+    RenderTexture2D target = {};
+    HudValues shown = {};
+    bool valid = false;
+    int redraws = 0; // Times the panel was drawn into the texture; shown with --render-stats
+};
+
+// Redraws the panel texture if the values differ from the ones it shows. Call it before
+// BeginDrawing(): it switches the render target.
+void UpdateHudCache(HudCache &hud, const HudValues &values, const std::vector<HudButton> &buttons,
+                    const Sprite &pauseButtonSprite, Rectangle pauseButtonRect) {
+    if (hud.target.id == 0) {
+        hud.target = LoadRenderTexture(SCREEN_WIDTH, UI_PANEL_HEIGHT);
+        hud.valid = false;
+    }
+    if (hud.valid && hud.shown == values) return;
+
+    // The camera maps the panel's screen rows onto the texture, so the same screen-space
+    // rects drive both the drawing and the click tests
+    Camera2D panelCamera = {};
+    panelCamera.target = {0.0f, (float) UI_PANEL_Y};
+    panelCamera.zoom = 1.0f;
+
+    BeginTextureMode(hud.target);
+    ClearBackground(CLITERAL(Color){50, 50, 50, 255});
+    BeginMode2D(panelCamera);
+
+    std::string sunText = "Sun: $" + std::to_string(values.sunCurrency);
+    DrawText(sunText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING, 20, YELLOW);
+
+    std::string scoreText = "Score: " + std::to_string(values.score);
+    DrawText(scoreText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING + 25, 20, WHITE);
+
+    std::string levelInfoText = "Level: " + std::to_string(values.level) + " | Target: " +
+                                std::to_string(values.targetScore);
+    DrawText(levelInfoText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING + 50, 20, RAYWHITE);
+
+    for (const HudButton &button: buttons) {
+        DrawIcon(button.icon, button.rect);
+        DrawText(TextFormat("$%d", button.cost), button.rect.x, button.rect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
+        if (values.selected == button.type) {
+            DrawRectangleLinesEx(button.rect, 3, YELLOW);
         }
+    }
+
+    DrawTextureRec(pauseButtonSprite.texture, pauseButtonSprite.region,
+                   (Vector2){pauseButtonRect.x, pauseButtonRect.y},
+                   WHITE);
+
+    EndMode2D();
+    EndTextureMode();
 
-        zombies.push_back(std::move(newZombie));
+    hud.shown = values;
+    hud.valid = true;
+    hud.redraws++;
+}
+
+void DrawHudCache(const HudCache &hud) {
+    BlitRenderTexture(hud.target, (Vector2){0, (float) UI_PANEL_Y});
+}
+
+void UnloadHudCache(HudCache &hud) {
+    if (hud.target.id > 0) {
+        UnloadRenderTexture(hud.target);
     }
+    hud = HudCache();
 }
 
-int main() {
+void ResetGame(Simulation &sim, PlantType &currentSelectedPlantType_ref, int levelToSet) {
+    sim.Reset(levelToSet);
+    currentSelectedPlantType_ref = PlantType::PEASHOOTER;
+}
+
+int main(int argc, char **argv) {
+    float simTickRate = SIM_TICK_RATE;
+    int jobThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    bool parallelLanes = false;
+    bool printJobStats = false;
+    bool useAtlas = true;
+    bool showRenderStats = false;
+    BoardConfig board;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            simTickRate = std::max(1.0f, (float) std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            // Size of the job system, including the main thread
+            jobThreads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--parallel-lanes") == 0) {
+            // Step the lanes as jobs instead of one after another on the main thread
+            parallelLanes = true;
+        } else if (std::strcmp(argv[i], "--job-stats") == 0) {
+            printJobStats = true;
+        } else if (std::strcmp(argv[i], "--no-atlas") == 0) {
+            // One texture per sprite, as before the atlas; for comparing draw costs
+            useAtlas = false;
+        } else if (std::strcmp(argv[i], "--render-stats") == 0) {
+            // Sprites, draw calls and batch flushes on screen (F3 toggles it in game)
+            showRenderStats = true;
+        } else if (std::strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+            // Lawn size as ROWSxCOLS, e.g. 20x100; bigger than the window scrolls
+            int rows = 0, cols = 0;
+            if (std::sscanf(argv[++i], "%dx%d", &rows, &cols) != 2 || rows < 1 || cols < 1) {
+                std::cerr << "--board expects ROWSxCOLS, e.g. 20x100" << std::endl;
+                return 1;
+            }
+            board = BoardConfig::WithSize(rows, cols);
+        }
+    }
+
+    JobSystem jobs(jobThreads);
+
+    StressConfig stressConfig;
+    if (!ParseStressArgs(argc, argv, stressConfig)) {
+        return 1;
+    }
+
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Plants vs. Zombies - C++/Raylib");
     InitAudioDevice();
     backgroundMusic = LoadMusicStream("resources/game_music.mp3");
     SetMusicVolume(backgroundMusic, 0.3f);
     PlayMusicStream(backgroundMusic);
 
-    // Load sounds
-    Sound shootSound = LoadSound("resources/shoot.mp3");
-    Sound hitSound = LoadSound("resources/hit.mp3");
-    Sound gameOverSound = LoadSound("resources/gameover.mp3");
-    Sound cherryBombExplosionSound = LoadSound("resources/explosion.mp3");
-    Sound lawnmowerSound = LoadSound("resources/lawnmower.mp3");
-    Sound digSound = LoadSound("resources/dig.mp3");
-
-    // Load textures
-    Texture2D peashooterTex = LoadTexture("resources/peashooter.png");
-    Texture2D sunflowerTex = LoadTexture("resources/sunflower.png");
-    Texture2D cherryBombTex = LoadTexture("resources/cherrybomb.png");
-    Texture2D wallnutTex = LoadTexture("resources/wallnut.png");
-    Texture2D regularZombieTex = LoadTexture("resources/regular_zombie.png");
-    Texture2D jumpingZombieTex = LoadTexture("resources/jumping_zombie.png");
-    Texture2D peaTex = LoadTexture("resources/pea.png");
-    Texture2D grassBackgroundTex = LoadTexture("resources/grass_background.png");
-    Texture2D pauseButtonTex = LoadTexture("resources/pause_button.png");
-    Texture2D mainMenuBackgroundTex = LoadTexture("resources/main_menu_background.png");
-    Texture2D lawnmowerTex = LoadTexture("resources/lawnmower.png");
-    Texture2D levelUpTex = LoadTexture("resources/levelup.png");
-    Texture2D shovelTex = LoadTexture("resources/shovel.png");
-    Texture2D repeaterTex = LoadTexture("resources/repeater.png");
-    Texture2D icePeaPlantTex = LoadTexture("resources/icepea.png");
-    Texture2D icePeaProjectileTex = LoadTexture("resources/pea.png");
+    // Load sounds and textures
+    Sound shootSound, hitSound, gameOverSound, cherryBombExplosionSound, lawnmowerSound, digSound;
+    Texture2D grassBackgroundTex, mainMenuBackgroundTex, levelUpTex;
+    Sprite peashooterSprite, sunflowerSprite, cherryBombSprite, wallnutSprite, regularZombieSprite, jumpingZombieSprite,
+            peaSprite, pauseButtonSprite, lawnmowerSprite, shovelSprite, repeaterSprite, icePeaPlantSprite,
+            icePeaProjectileSprite;
+
+    std::vector<SoundFile> soundFiles = {
+        {"resources/shoot.mp3", &shootSound, {}},
+        {"resources/hit.mp3", &hitSound, {}},
+        {"resources/gameover.mp3", &gameOverSound, {}},
+        {"resources/explosion.mp3", &cherryBombExplosionSound, {}},
+        {"resources/lawnmower.mp3", &lawnmowerSound, {}},
+        {"resources/dig.mp3", &digSound, {}},
+    };
+    // The full-screen backgrounds keep textures of their own; everything drawn many times
+    // a frame shares the atlas
+    std::vector<TextureFile> textureFiles = {
+        {"resources/grass_background.png", &grassBackgroundTex, {}},
+        {"resources/main_menu_background.png", &mainMenuBackgroundTex, {}},
+        {"resources/levelup.png", &levelUpTex, {}},
+    };
+    std::vector<SpriteFile> spriteFiles = {
+        {"resources/peashooter.png", &peashooterSprite, {}},
+        {"resources/sunflower.png", &sunflowerSprite, {}},
+        {"resources/cherrybomb.png", &cherryBombSprite, {}},
+        {"resources/wallnut.png", &wallnutSprite, {}},
+        {"resources/regular_zombie.png", &regularZombieSprite, {}},
+        {"resources/jumping_zombie.png", &jumpingZombieSprite, {}},
+        {"resources/pea.png", &peaSprite, {}},
+        {"resources/pause_button.png", &pauseButtonSprite, {}},
+        {"resources/lawnmower.png", &lawnmowerSprite, {}},
+        {"resources/shovel.png", &shovelSprite, {}},
+        {"resources/repeater.png", &repeaterSprite, {}},
+        {"resources/icepea.png", &icePeaPlantSprite, {}},
+        {"resources/pea.png", &icePeaProjectileSprite, {}},
+    };
+    TextureAtlas atlas;
+    std::vector<Texture2D> looseSpriteTextures;
+    LoadAssets(jobs, textureFiles, spriteFiles, soundFiles, useAtlas, atlas, looseSpriteTextures);
+
+    SimulationAssets assets;
+    assets.peashooterSprite = peashooterSprite;
+    assets.sunflowerSprite = sunflowerSprite;
+    assets.cherryBombSprite = cherryBombSprite;
+    assets.wallnutSprite = wallnutSprite;
+    assets.repeaterSprite = repeaterSprite;
+    assets.icePeaPlantSprite = icePeaPlantSprite;
+    assets.regularZombieSprite = regularZombieSprite;
+    assets.jumpingZombieSprite = jumpingZombieSprite;
+    assets.peaSprite = peaSprite;
+    assets.icePeaProjectileSprite = icePeaProjectileSprite;
+    assets.lawnmowerSprite = lawnmowerSprite;
+    assets.shootSound = shootSound;
+    assets.hitSound = hitSound;
+    assets.gameOverSound = gameOverSound;
+    assets.cherryBombExplosionSound = cherryBombExplosionSound;
+    assets.lawnmowerSound = lawnmowerSound;
+    assets.digSound = digSound;
 
     // Define UI rectangles
     Rectangle pauseButtonRect = {
@@ -145,85 +485,74 @@ int main() {
         (float) PAUSE_BUTTON_SIZE
     };
 
-    Rectangle peashooterIconRect = {
-        (float) UI_PANEL_PADDING + 400,
-        (float) UI_PANEL_Y + UI_PANEL_PADDING,
-        (float) PLANT_ICON_SIZE,
-        (float) PLANT_ICON_SIZE
-    };
-
-    Rectangle sunflowerIconRect = {
-        peashooterIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float) UI_PANEL_Y + UI_PANEL_PADDING,
-        (float) PLANT_ICON_SIZE,
-        (float) PLANT_ICON_SIZE
-    };
-
-    Rectangle cherryBombIconRect = {
-        sunflowerIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float) UI_PANEL_Y + UI_PANEL_PADDING,
-        (float) PLANT_ICON_SIZE,
-        (float) PLANT_ICON_SIZE
-    };
-
-    Rectangle wallnutIconRect = {
-        cherryBombIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float) UI_PANEL_Y + UI_PANEL_PADDING,
-        (float) PLANT_ICON_SIZE,
-        (float) PLANT_ICON_SIZE
-    };
-
-    Rectangle shovelIconRect = {
-        wallnutIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float) UI_PANEL_Y + UI_PANEL_PADDING,
-        (float) PLANT_ICON_SIZE,
-        (float) PLANT_ICON_SIZE
-    };
-
-    Rectangle repeaterIconRect = {
-        shovelIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float) UI_PANEL_Y + UI_PANEL_PADDING,
-        (float) PLANT_ICON_SIZE,
-        (float) PLANT_ICON_SIZE
+    // The plant buttons, left to right. The HUD cache draws them and the click handling
+    // tests against them, so this table is the only place their layout lives.
+    std::vector<HudButton> hudButtons = {
+        {PlantType::PEASHOOTER, "Peashooter", 50, peashooterSprite, {}},
+        {PlantType::SUNFLOWER, "Sunflower", 25, sunflowerSprite, {}},
+        {PlantType::CHERRY_BOMB, "Cherry Bomb", 50, cherryBombSprite, {}},
+        {PlantType::WALNUT, "Wall-nut", 75, wallnutSprite, {}},
+        {PlantType::SHOVEL, "Shovel", 0, shovelSprite, {}},
+        {PlantType::REPEATER, "Repeater", 200, repeaterSprite, {}},
+        {PlantType::ICE_PEA, "Ice Pea", 150, icePeaPlantSprite, {}},
     };
+    for (size_t i = 0; i < hudButtons.size(); ++i) {
+        hudButtons[i].rect = {
+            (float) UI_PANEL_PADDING + 400 + i * (PLANT_ICON_SIZE + PLANT_ICON_SPACING),
+            (float) UI_PANEL_Y + UI_PANEL_PADDING,
+            (float) PLANT_ICON_SIZE,
+            (float) PLANT_ICON_SIZE
+        };
+    }
+    HudCache hud;
+    BackgroundCache background;
 
-    Rectangle icePeaIconRect = {
-        repeaterIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float) UI_PANEL_Y + UI_PANEL_PADDING,
-        (float) PLANT_ICON_SIZE,
-        (float) PLANT_ICON_SIZE
-    };
+    Rectangle continueButtonRect = {(float) (SCREEN_WIDTH / 2 - 100), (float) (SCREEN_HEIGHT / 2 + 50), 200, 50};
+    Rectangle levelMainMenuButtonRect = {(float) (SCREEN_WIDTH / 2 - 100), (float) (SCREEN_HEIGHT / 2 + 110), 200, 50};
+    Rectangle replayLevelButtonRect = {(float) (SCREEN_WIDTH / 2 - 100), (float) (SCREEN_HEIGHT / 2 + 170), 200, 50};
 
-    Rectangle continueButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 50, 200, 50};
-    Rectangle levelMainMenuButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 110, 200, 50};
-    Rectangle replayLevelButtonRect = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 170, 200, 50};
+    Simulation sim(assets, simTickRate, board);
+    if (parallelLanes) {
+        sim.jobs = &jobs;
+    }
+    GameState currentGameState = MAIN_MENU;
 
-    std::vector<std::unique_ptr<Plant> > plants;
-    std::vector<std::unique_ptr<Zombie> > zombies;
-    std::vector<std::unique_ptr<Projectile> > projectiles;
-    std::vector<std::unique_ptr<LawnMower> > lawnmowers;
+    // Stress mode skips the menu and keeps the lawn full until the window closes
+    StressDriver stress(stressConfig);
+    FrameStats frameStats;
+    float stressElapsed = 0.0f;
+    if (stressConfig.enabled) {
+        stress.Populate(sim);
+        currentGameState = GAMEPLAY;
+    }
 
-    float zombieSpawnTimer = 0.0f;
-    float zombieSpawnRate = 5.0f;
-    GameState currentGameState = MAIN_MENU;
+    Camera2D camera = {};
+    camera.zoom = 1.0f;
+    RenderQueue renderQueue; // World sprites, sorted and batched once per frame
 
-    SetTargetFPS(60);
+    // Stress mode runs uncapped: EndDrawing() would otherwise sleep every frame up to
+    // 16.67 ms and every frame would look like it only just made the 60 FPS budget
+    SetTargetFPS(stressConfig.enabled ? 0 : 60);
 
     while (!WindowShouldClose()) {
+        double frameStart = GetTime();
         float deltaTime = GetFrameTime();
+        double driverStart = 0.0; // Stress harness work (replanting, spawning), kept out of the update time
+        double updateStart = 0.0;
+        double updateEnd = 0.0;
         UpdateMusicStream(backgroundMusic);
+        if (IsKeyPressed(KEY_F3)) {
+            showRenderStats = !showRenderStats;
+        }
         switch (currentGameState) {
             case MAIN_MENU: {
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                     Vector2 mousePos = GetMousePosition();
-                    Rectangle playButton = {250, SCREEN_HEIGHT / 2 - 80, 300, 100};
-                    Rectangle exitButton = {950, SCREEN_HEIGHT / 2 + 250, 300, 100};
+                    Rectangle playButton = {250, (float) (SCREEN_HEIGHT / 2 - 80), 300, 100};
+                    Rectangle exitButton = {950, (float) (SCREEN_HEIGHT / 2 + 250), 300, 100};
 
                     if (CheckCollisionPointRec(mousePos, playButton)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, 1);
+                        ResetGame(sim, currentSelectedPlantType, 1);
                         currentGameState = GAMEPLAY;
                     } else if (CheckCollisionPointRec(mousePos, exitButton)) {
                         CloseWindow();
@@ -233,242 +562,63 @@ int main() {
             }
 
             case GAMEPLAY: {
+                ScrollBoardCamera(camera, board, deltaTime);
+
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                     Vector2 mousePos = GetMousePosition();
 
                     if (CheckCollisionPointRec(mousePos, pauseButtonRect)) {
                         currentGameState = PAUSED;
-                    } else if (CheckCollisionPointRec(mousePos, peashooterIconRect)) {
-                        if (sunCurrency >= 50) currentSelectedPlantType = PlantType::PEASHOOTER;
-                        else std::cout << "Not enough sun for Peashooter!" << std::endl;
-                    } else if (CheckCollisionPointRec(mousePos, sunflowerIconRect)) {
-                        if (sunCurrency >= 25) currentSelectedPlantType = PlantType::SUNFLOWER;
-                        else std::cout << "Not enough sun for Sunflower!" << std::endl;
-                    } else if (CheckCollisionPointRec(mousePos, cherryBombIconRect)) {
-                        if (sunCurrency >= 50) currentSelectedPlantType = PlantType::CHERRY_BOMB;
-                        else std::cout << "Not enough sun for Cherry Bomb!" << std::endl;
-                    } else if (CheckCollisionPointRec(mousePos, wallnutIconRect)) {
-                        if (sunCurrency >= 75) currentSelectedPlantType = PlantType::WALNUT;
-                        else std::cout << "Not enough sun for Wall-nut!" << std::endl;
-                    } else if (CheckCollisionPointRec(mousePos, shovelIconRect)) {
-                        currentSelectedPlantType = PlantType::SHOVEL;
-                    } else if (CheckCollisionPointRec(mousePos, repeaterIconRect)) {
-                        if (sunCurrency >= 200) currentSelectedPlantType = PlantType::REPEATER;
-                        else std::cout << "Not enough sun for Repeater!" << std::endl;
-                    } else if (CheckCollisionPointRec(mousePos, icePeaIconRect)) {
-                        if (sunCurrency >= 150) currentSelectedPlantType = PlantType::ICE_PEA;
-                        else std::cout << "Not enough sun for Ice Pea!" << std::endl;
-                    } else if (CheckCollisionPointRec(mousePos, {
-                                                          (float) GRID_START_X, (float) GRID_START_Y,
-                                                          (float) (GRID_COLS * TILE_SIZE),
-                                                          (float) (GRID_ROWS * TILE_SIZE)
-                                                      })) {
-                        int col = (mousePos.x - GRID_START_X) / TILE_SIZE;
-                        int row = (mousePos.y - GRID_START_Y) / TILE_SIZE;
-
-                        if (currentSelectedPlantType == PlantType::SHOVEL) {
-                            for (int i = plants.size() - 1; i >= 0; --i) {
-                                if (plants[i]->row == row && plants[i]->col == col) {
-                                    plants.erase(plants.begin() + i);
-                                    PlaySound(digSound);
-                                    break;
-                                }
-                            }
-                        } else {
-                            bool plantExists = false;
-                            for (const auto &plant: plants) {
-                                if (plant->row == row && plant->col == col) {
-                                    plantExists = true;
-                                    break;
-                                }
-                            }
-
-                            if (!plantExists) {
-                                std::unique_ptr<Plant> newPlant = nullptr;
-                                Rectangle plantRect = {
-                                    (float) GRID_START_X + col * TILE_SIZE + (TILE_SIZE / 4.0f),
-                                    (float) GRID_START_Y + row * TILE_SIZE + (TILE_SIZE / 4.0f),
-                                    TILE_SIZE / 2.0f * 1.8f,
-                                    TILE_SIZE / 2.0f * 1.8f
-                                };
-
-                                switch (currentSelectedPlantType) {
-                                    case PlantType::PEASHOOTER:
-                                        if (sunCurrency >= 50) newPlant = std::make_unique<Peashooter>(
-                                                                   plantRect, row, col, peashooterTex);
-                                        break;
-                                    case PlantType::SUNFLOWER:
-                                        if (sunCurrency >= 25) newPlant = std::make_unique<Sunflower>(
-                                                                   plantRect, row, col, sunflowerTex);
-                                        break;
-                                    case PlantType::CHERRY_BOMB:
-                                        if (sunCurrency >= 50) newPlant = std::make_unique<CherryBomb>(
-                                                                   plantRect, row, col, cherryBombTex,
-                                                                   cherryBombExplosionSound);
-                                        break;
-                                    case PlantType::WALNUT:
-                                        if (sunCurrency >= 75) newPlant = std::make_unique<WallNut>(
-                                                                   plantRect, row, col, wallnutTex);
-                                        break;
-                                    case PlantType::REPEATER:
-                                        if (sunCurrency >= 200) newPlant = std::make_unique<Repeater>(
-                                                                    plantRect, row, col, repeaterTex);
-                                        break;
-                                    case PlantType::ICE_PEA:
-                                        if (sunCurrency >= 150) newPlant = std::make_unique<IcePea>(
-                                                                    plantRect, row, col, icePeaPlantTex,
-                                                                    icePeaProjectileTex);
-                                        break;
-                                    default:
-                                        break;
-                                }
-
-                                if (newPlant) {
-                                    sunCurrency -= newPlant->GetCost();
-                                    plants.push_back(std::move(newPlant));
-                                }
+                    } else if (const HudButton *button = HudButtonAt(hudButtons, mousePos)) {
+                        if (sim.sunCurrency >= button->cost) currentSelectedPlantType = button->type;
+                        else std::cout << "Not enough sun for " << button->name << "!" << std::endl;
+                    } else if (mousePos.y >= UI_PANEL_Y + UI_PANEL_HEIGHT) {
+                        // The lawn scrolls under the panel, so only clicks below it reach the board
+                        Vector2 worldPos = GetScreenToWorld2D(mousePos, camera);
+                        int col = board.ColumnAt(worldPos.x);
+                        int row = board.RowAt(worldPos.y);
+
+                        if (sim.world.InBounds(row, col)) {
+                            if (currentSelectedPlantType == PlantType::SHOVEL) {
+                                sim.RemovePlant(row, col);
+                            } else {
+                                sim.PlacePlant(currentSelectedPlantType, row, col);
                             }
                         }
                     }
                 }
 
-                if (score >= targetScore) {
+                if (sim.LevelComplete()) {
                     currentGameState = LEVEL_UP_SCREEN;
                     break;
                 }
 
-                zombieSpawnTimer += deltaTime;
-                if (zombieSpawnTimer >= zombieSpawnRate) {
-                    zombieSpawnTimer = 0.0f;
-                    int spawnRow = GetRandomValue(0, GRID_ROWS - 1);
-
-                    std::unique_ptr<Zombie> newZombie = nullptr;
-                    Rectangle zombieRect = {
-                        (float) SCREEN_WIDTH,
-                        (float) GRID_START_Y + spawnRow * TILE_SIZE + (TILE_SIZE / 4.0f),
-                        TILE_SIZE / 2.0f * 2.8f,
-                        TILE_SIZE / 2.0f * 2.8f
-                    };
-
-                    if (GetRandomValue(0, 1) == 0) {
-                        newZombie = std::make_unique<RegularZombie>(zombieRect, spawnRow, regularZombieTex,
-                                                                    currentLevel);
-                    } else {
-                        newZombie = std::make_unique<JumpingZombie>(zombieRect, spawnRow, jumpingZombieTex,
-                                                                    currentLevel);
-                    }
-
-                    zombies.push_back(std::move(newZombie));
-                }
-
-                for (auto &plant: plants) {
-                    if (plant->active) {
-                        plant->Update(deltaTime, zombies, projectiles, sunCurrency, shootSound, peaTex);
-                    }
-                }
-
-                for (int i = zombies.size() - 1; i >= 0; --i) {
-                    zombies[i]->Update(deltaTime, plants);
-
-                    if (zombies[i]->health <= 0 && zombies[i]->active) {
-                        score += zombies[i]->scoreValue;
-                        zombies[i]->active = false;
-                    }
-
-                    if (!zombies[i]->active) {
-                        zombies.erase(zombies.begin() + i);
-                        continue;
-                    }
-
-                    if (zombies[i]->rect.x <= GRID_START_X - TILE_SIZE / 2 && (size_t) zombies[i]->row < lawnmowers.
-                        size()) {
-                        LawnMower *mower = lawnmowers[zombies[i]->row].get();
-                        if (mower && !mower->activated) {
-                            mower->activated = true;
-                            PlaySound(lawnmowerSound);
-                        }
-                    }
-
-                    if (zombies[i]->rect.x < GRID_START_X - TILE_SIZE) {
-                        currentGameState = GAME_OVER;
-                        PlaySound(gameOverSound);
-                        break;
-                    }
-                }
-
-                if (currentGameState == GAME_OVER) break;
-
-                for (int p_idx = projectiles.size() - 1; p_idx >= 0; --p_idx) {
-                    projectiles[p_idx]->rect.x += projectiles[p_idx]->speed.x * deltaTime;
-
-                    if (projectiles[p_idx]->rect.x > SCREEN_WIDTH) {
-                        projectiles[p_idx]->active = false;
-                    }
-
-                    if (!projectiles[p_idx]->active) {
-                        projectiles.erase(projectiles.begin() + p_idx);
-                        continue;
-                    }
-
-                    for (auto &zombie: zombies) {
-                        if (!zombie->active) continue;
-
-                        if (CheckCollisionRecs(projectiles[p_idx]->rect, zombie->rect)) {
-                            if (projectiles[p_idx]->type == ProjectileType::FROZEN) {
-                                zombie->ApplySlowEffect();
-                            }
-                            zombie->health -= projectiles[p_idx]->damage;
-                            projectiles[p_idx]->active = false;
-                            PlaySound(hitSound);
-
-                            if (zombie->health <= 0) {
-                                score += zombie->scoreValue;
-                                zombie->active = false;
-                            }
-                            break;
-                        }
-                    }
+                driverStart = GetTime();
+                if (stressConfig.enabled) {
+                    stress.Update(sim, deltaTime);
                 }
+                updateStart = GetTime();
+                sim.Advance(deltaTime);
+                updateEnd = GetTime();
 
-                for (auto &mower: lawnmowers) {
-                    if (mower->activated && mower->active) {
-                        mower->Update(deltaTime);
-                        for (auto &zombie: zombies) {
-                            if (zombie->active && mower->row == zombie->row && CheckCollisionRecs(
-                                    mower->rect, zombie->rect)) {
-                                if (zombie->active) {
-                                    score += zombie->scoreValue;
-                                }
-                                zombie->health = 0;
-                                zombie->active = false;
-                            }
-                        }
-                        if (mower->rect.x > SCREEN_WIDTH + TILE_SIZE) {
-                            mower->active = false;
-                        }
-                    }
+                // In stress mode the driver rebuilds the board on the next frame instead
+                if (sim.gameOver && !stressConfig.enabled) {
+                    currentGameState = GAME_OVER;
                 }
 
-                plants.erase(std::remove_if(plants.begin(), plants.end(),
-                                            [](const std::unique_ptr<Plant> &p) { return !p->active; }),
-                             plants.end());
-
                 break;
             }
 
             case PAUSED: {
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                     Vector2 mousePos = GetMousePosition();
-                    Rectangle resumeButton = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 200, 50};
-                    Rectangle exitButton = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 20, 200, 50};
+                    Rectangle resumeButton = {(float) (SCREEN_WIDTH / 2 - 100), (float) (SCREEN_HEIGHT / 2 - 50), 200, 50};
+                    Rectangle exitButton = {(float) (SCREEN_WIDTH / 2 - 100), (float) (SCREEN_HEIGHT / 2 + 20), 200, 50};
 
                     if (CheckCollisionPointRec(mousePos, resumeButton)) {
                         currentGameState = GAMEPLAY;
                     } else if (CheckCollisionPointRec(mousePos, exitButton)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, 1);
+                        ResetGame(sim, currentSelectedPlantType, 1);
                         currentGameState = MAIN_MENU;
                     }
                 }
@@ -479,22 +629,13 @@ int main() {
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                     Vector2 mousePos = GetMousePosition();
                     if (CheckCollisionPointRec(mousePos, continueButtonRect)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, currentLevel + 1);
+                        ResetGame(sim, currentSelectedPlantType, sim.currentLevel + 1);
                         currentGameState = GAMEPLAY;
                     } else if (CheckCollisionPointRec(mousePos, levelMainMenuButtonRect)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, 1);
+                        ResetGame(sim, currentSelectedPlantType, 1);
                         currentGameState = MAIN_MENU;
                     } else if (CheckCollisionPointRec(mousePos, replayLevelButtonRect)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, currentLevel);
+                        ResetGame(sim, currentSelectedPlantType, sim.currentLevel);
                         currentGameState = GAMEPLAY;
                     }
                 }
@@ -503,10 +644,7 @@ int main() {
 
             case GAME_OVER: {
                 if (IsKeyPressed(KEY_R)) {
-                    ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                              regularZombieTex, jumpingZombieTex,
-                              zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                              currentSelectedPlantType, 1);
+                    ResetGame(sim, currentSelectedPlantType, 1);
                     currentGameState = GAMEPLAY;
                 }
                 if (IsKeyPressed(KEY_Q)) {
@@ -516,33 +654,36 @@ int main() {
             }
         }
 
+        double drawStart = GetTime();
+        renderQueue.ResetStats();
+        if (currentGameState == GAMEPLAY) {
+            HudValues hudValues = {
+                sim.sunCurrency, sim.score, sim.currentLevel, sim.targetScore, currentSelectedPlantType
+            };
+            UpdateHudCache(hud, hudValues, hudButtons, pauseButtonSprite, pauseButtonRect);
+        }
+        BackgroundKind backgroundKind = currentGameState == MAIN_MENU
+                                            ? BackgroundKind::MAIN_MENU
+                                            : currentGameState == LEVEL_UP_SCREEN
+                                                  ? BackgroundKind::LAWN
+                                                  : BackgroundKind::LAWN_AND_PANEL;
+        UpdateBackgroundCache(background, backgroundKind, camera, board, mainMenuBackgroundTex, grassBackgroundTex);
         BeginDrawing();
-        ClearBackground(DARKGRAY);
+        // The backdrop is opaque and covers the window, so it doubles as the clear
+        DrawBackgroundCache(background);
 
         if (currentGameState == MAIN_MENU) {
-            DrawTexturePro(mainMenuBackgroundTex,
-                           (Rectangle){0, 0, (float) mainMenuBackgroundTex.width, (float) mainMenuBackgroundTex.height},
-                           (Rectangle){0, 0, (float) SCREEN_WIDTH, (float) SCREEN_HEIGHT},
-                           (Vector2){0, 0}, 0.0f, WHITE);
 
-            Rectangle playButton = {250, SCREEN_HEIGHT / 2 - 80, 300, 100};
+            Rectangle playButton = {250, (float) (SCREEN_HEIGHT / 2 - 80), 300, 100};
             DrawRectangleRec(playButton, BLANK);
             DrawText("PLAY", playButton.x + (playButton.width - MeasureText("PLAY", 40)) / 2,
                      playButton.y + (playButton.height - 40) / 2, 40, BLANK);
 
-            Rectangle exitButton = {950, SCREEN_HEIGHT / 2 + 250, 300, 100};
+            Rectangle exitButton = {950, (float) (SCREEN_HEIGHT / 2 + 250), 300, 100};
             DrawRectangleRec(exitButton, RED);
             DrawText("EXIT", exitButton.x + (exitButton.width - MeasureText("EXIT", 40)) / 2,
                      exitButton.y + (exitButton.height - 40) / 2, 40, BLACK);
         } else if (currentGameState == LEVEL_UP_SCREEN) {
-            DrawTexturePro(grassBackgroundTex,
-                           (Rectangle){0, 0, (float) grassBackgroundTex.width, (float) grassBackgroundTex.height},
-                           (Rectangle){
-                               (float) GRID_START_X, (float) GRID_START_Y,
-                               (float) (GRID_COLS * TILE_SIZE), (float) (GRID_ROWS * TILE_SIZE)
-                           },
-                           (Vector2){0, 0}, 0.0f, WHITE);
-
             DrawTexturePro(levelUpTex,
                            (Rectangle){0, 0, (float) levelUpTex.width, (float) levelUpTex.height},
                            (Rectangle){
@@ -554,12 +695,12 @@ int main() {
 
             DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.7f));
 
-            std::string levelUpText = "LEVEL " + std::to_string(currentLevel) + " COMPLETE!";
+            std::string levelUpText = "LEVEL " + std::to_string(sim.currentLevel) + " COMPLETE!";
             DrawText(levelUpText.c_str(),
                      SCREEN_WIDTH / 2 - MeasureText(levelUpText.c_str(), 60) / 2,
                      SCREEN_HEIGHT / 2 - 120, 60, YELLOW);
 
-            std::string nextTargetText = "Next Target: " + std::to_string(CalculateTargetScore(currentLevel + 1)) +
+            std::string nextTargetText = "Next Target: " + std::to_string(CalculateTargetScore(sim.currentLevel + 1)) +
                                          " Points";
             DrawText(nextTargetText.c_str(),
                      SCREEN_WIDTH / 2 - MeasureText(nextTargetText.c_str(), 30) / 2,
@@ -580,96 +721,60 @@ int main() {
                      replayLevelButtonRect.x + (replayLevelButtonRect.width - MeasureText("REPLAY", 30)) / 2,
                      replayLevelButtonRect.y + (replayLevelButtonRect.height - 30) / 2, 30, BLACK);
         } else {
-            DrawRectangle(0, UI_PANEL_Y, SCREEN_WIDTH, UI_PANEL_HEIGHT, CLITERAL(Color){50, 50, 50, 255});
-
-            DrawTexturePro(grassBackgroundTex,
-                           (Rectangle){0, 0, (float) grassBackgroundTex.width, (float) grassBackgroundTex.height},
-                           (Rectangle){
-                               (float) GRID_START_X, (float) GRID_START_Y,
-                               (float) (GRID_COLS * TILE_SIZE), (float) (GRID_ROWS * TILE_SIZE)
-                           },
-                           (Vector2){0, 0}, 0.0f, WHITE);
+            // World space: everything on the lawn, scrolled by the camera
+            BeginMode2D(camera);
 
             if (currentGameState == GAMEPLAY) {
-                for (const auto &plant: plants) {
-                    plant->Draw();
-                }
-                for (const auto &zombie: zombies) {
-                    zombie->Draw();
-                }
-                for (const auto &projectile: projectiles) {
-                    if (projectile->active) {
-                        DrawTextureRec(projectile->texture, projectile->sourceRect,
-                                       {projectile->rect.x, projectile->rect.y}, WHITE);
+                // Only the rows in view are drawn, and in each row only the tiles, zombies and
+                // peas in view, so a huge arena costs about as much to draw as the screen holds
+                TileRange visible = VisibleTiles(board, camera, 1);
+                const float viewLeft = camera.target.x - board.tileSize;
+                const float viewRight = camera.target.x + SCREEN_WIDTH + board.tileSize;
+
+                for (int row = visible.firstRow; row <= visible.lastRow; ++row) {
+                    for (int col = visible.firstCol; col <= visible.lastCol; ++col) {
+                        if (Plant *plant = sim.world.PlantAt(row, col)) {
+                            plant->Draw(renderQueue);
+                        }
                     }
                 }
-                for (const auto &mower: lawnmowers) {
-                    mower->Draw();
-                }
-
-                std::string sunText = "Sun: $" + std::to_string(sunCurrency);
-                DrawText(sunText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING, 20, YELLOW);
-
-                std::string scoreText = "Score: " + std::to_string(score);
-                DrawText(scoreText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING + 25, 20, WHITE);
-
-                std::string levelInfoText = "Level: " + std::to_string(currentLevel) + " | Target: " + std::to_string(
-                                                targetScore);
-                DrawText(levelInfoText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING + 50, 20, RAYWHITE);
-
-                DrawTextureEx(peashooterTex, (Vector2){peashooterIconRect.x, peashooterIconRect.y},
-                              0.0f, PLANT_ICON_SIZE / (float) peashooterTex.width, WHITE);
-                DrawText("$50", peashooterIconRect.x, peashooterIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                if (currentSelectedPlantType == PlantType::PEASHOOTER) {
-                    DrawRectangleLinesEx(peashooterIconRect, 3, YELLOW);
-                }
-
-                DrawTextureEx(sunflowerTex, (Vector2){sunflowerIconRect.x, sunflowerIconRect.y},
-                              0.0f, PLANT_ICON_SIZE / (float) sunflowerTex.width, WHITE);
-                DrawText("$25", sunflowerIconRect.x, sunflowerIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                if (currentSelectedPlantType == PlantType::SUNFLOWER) {
-                    DrawRectangleLinesEx(sunflowerIconRect, 3, YELLOW);
-                }
-
-                DrawTextureEx(cherryBombTex, (Vector2){cherryBombIconRect.x, cherryBombIconRect.y},
-                              0.0f, PLANT_ICON_SIZE / (float) cherryBombTex.width, WHITE);
-                DrawText("$50", cherryBombIconRect.x, cherryBombIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                if (currentSelectedPlantType == PlantType::CHERRY_BOMB) {
-                    DrawRectangleLinesEx(cherryBombIconRect, 3, YELLOW);
-                }
-
-                DrawTextureEx(wallnutTex, (Vector2){wallnutIconRect.x, wallnutIconRect.y},
-                              0.0f, PLANT_ICON_SIZE / (float) wallnutTex.width, WHITE);
-                DrawText("$75", wallnutIconRect.x, wallnutIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                if (currentSelectedPlantType == PlantType::WALNUT) {
-                    DrawRectangleLinesEx(wallnutIconRect, 3, YELLOW);
-                }
-
-                DrawTextureEx(shovelTex, (Vector2){shovelIconRect.x, shovelIconRect.y},
-                              0.0f, PLANT_ICON_SIZE / (float) shovelTex.width, WHITE);
-                DrawText("$0", shovelIconRect.x, shovelIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                if (currentSelectedPlantType == PlantType::SHOVEL) {
-                    DrawRectangleLinesEx(shovelIconRect, 3, YELLOW);
+                const float alpha = sim.InterpolationAlpha();
+                for (int row = visible.firstRow; row <= visible.lastRow; ++row) {
+                    const Lane &lane = sim.world.GetLane(row);
+                    for (size_t i = lane.FirstZombieFrom(viewLeft - lane.maxZombieWidth); i < lane.zombies.size(); ++i) {
+                        if (lane.zombies[i]->rect.x > viewRight) break;
+                        lane.zombies[i]->Draw(renderQueue, alpha);
+                    }
                 }
-
-                DrawTextureEx(repeaterTex, (Vector2){repeaterIconRect.x, repeaterIconRect.y},
-                              0.0f, PLANT_ICON_SIZE / (float) repeaterTex.width, WHITE);
-                DrawText("$200", repeaterIconRect.x, repeaterIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                if (currentSelectedPlantType == PlantType::REPEATER) {
-                    DrawRectangleLinesEx(repeaterIconRect, 3, YELLOW);
+                for (int row = visible.firstRow; row <= visible.lastRow; ++row) {
+                    const ProjectileStore &projectiles = sim.world.GetLane(row).projectiles;
+                    for (size_t i = 0; i < projectiles.Count(); ++i) {
+                        if (projectiles.alive[i] && projectiles.x[i] > viewLeft && projectiles.x[i] < viewRight) {
+                            const Sprite &projectileSprite = projectiles.type[i] == ProjectileType::FROZEN
+                                                                 ? icePeaProjectileSprite
+                                                                 : peaSprite;
+                            renderQueue.Push(RenderLayer::PROJECTILES, row, projectileSprite, {
+                                                 LerpFloat(projectiles.prevX[i], projectiles.x[i], alpha),
+                                                 projectiles.y[i],
+                                                 projectileSprite.region.width, projectileSprite.region.height
+                                             });
+                        }
+                    }
                 }
-
-                DrawTextureEx(icePeaPlantTex, (Vector2){icePeaIconRect.x, icePeaIconRect.y},
-                              0.0f, PLANT_ICON_SIZE / (float) icePeaPlantTex.width, WHITE);
-                DrawText("$150", icePeaIconRect.x, icePeaIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                if (currentSelectedPlantType == PlantType::ICE_PEA) {
-                    DrawRectangleLinesEx(icePeaIconRect, 3, YELLOW);
+                for (int row = visible.firstRow; row <= visible.lastRow; ++row) {
+                    const Lane &lane = sim.world.GetLane(row);
+                    if (lane.mower) {
+                        lane.mower->Draw(renderQueue, alpha);
+                    }
                 }
+                renderQueue.Flush();
+            }
+            EndMode2D();
 
-                DrawTextureRec(pauseButtonTex,
-                               (Rectangle){0, 0, (float) pauseButtonTex.width, (float) pauseButtonTex.height},
-                               (Vector2){pauseButtonRect.x, pauseButtonRect.y},
-                               WHITE);
+            // Screen space: the UI panel stays put while the lawn scrolls underneath. The empty
+            // panel is part of the backdrop; in game the opaque HUD texture covers it.
+            if (currentGameState == GAMEPLAY) {
+                DrawHudCache(hud);
             }
 
             if (currentGameState == GAME_OVER) {
@@ -678,7 +783,7 @@ int main() {
                          SCREEN_HEIGHT / 2 - 80, 80, RED);
 
                 const char *scoreLabel = "Your Score: ";
-                std::string scoreValueStr = std::to_string(score);
+                std::string scoreValueStr = std::to_string(sim.score);
 
                 int scoreLabelWidth = MeasureText(scoreLabel, 40);
                 int scoreValueWidth = MeasureText(scoreValueStr.c_str(), 40);
@@ -703,19 +808,57 @@ int main() {
                 DrawText("PAUSED", SCREEN_WIDTH / 2 - MeasureText("PAUSED", 80) / 2,
                          SCREEN_HEIGHT / 2 - 150, 80, RAYWHITE);
 
-                Rectangle resumeButton = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 200, 50};
+                Rectangle resumeButton = {(float) (SCREEN_WIDTH / 2 - 100), (float) (SCREEN_HEIGHT / 2 - 50), 200, 50};
                 DrawRectangleRec(resumeButton, LIGHTGRAY);
                 DrawText("RESUME", resumeButton.x + (resumeButton.width - MeasureText("RESUME", 30)) / 2,
                          resumeButton.y + (resumeButton.height - 30) / 2, 30, BLACK);
 
-                Rectangle exitButton = {SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 20, 200, 50};
+                Rectangle exitButton = {(float) (SCREEN_WIDTH / 2 - 100), (float) (SCREEN_HEIGHT / 2 + 20), 200, 50};
                 DrawRectangleRec(exitButton, GRAY);
                 DrawText("MAIN MENU", exitButton.x + (exitButton.width - MeasureText("MAIN MENU", 30)) / 2,
                          exitButton.y + (exitButton.height - 30) / 2, 30, BLACK);
             }
         }
 
+        if (showRenderStats) {
+            const RenderStats &render = renderQueue.Stats();
+            std::string renderText = "Sprites: " + std::to_string(render.sprites) +
+                                     " | Draw calls: " + std::to_string(render.drawCalls) +
+                                     " | Batch flushes: " + std::to_string(render.batchFlushes) +
+                                     " | HUD redraws: " + std::to_string(hud.redraws) +
+                                     " | Backdrop rebuilds: " + std::to_string(background.rebuilds);
+            DrawText(renderText.c_str(), UI_PANEL_PADDING, SCREEN_HEIGHT - 30, 20, LIME);
+        }
+
+        // Sampled before EndDrawing(), which also submits the batch and swaps buffers
+        double drawEnd = GetTime();
         EndDrawing();
+        double frameEnd = GetTime();
+
+        if (stressConfig.enabled && currentGameState == GAMEPLAY) {
+            // Timed here rather than read from GetFrameTime(), which is the previous frame's
+            // and would not line up with this frame's update/draw times and entity count
+            frameStats.AddFrame((float) ((frameEnd - frameStart) * 1000.0),
+                                (float) ((updateStart - driverStart) * 1000.0),
+                                (float) ((updateEnd - updateStart) * 1000.0),
+                                (float) ((drawEnd - drawStart) * 1000.0),
+                                sim.world.PlantCount() + sim.world.ZombieCount() + sim.world.ProjectileCount(),
+                                sim.world.ProjectileCount(), renderQueue.Stats());
+
+            stressElapsed += deltaTime;
+            if (stressConfig.duration > 0.0f && stressElapsed >= stressConfig.duration) {
+                break;
+            }
+        }
+    }
+
+    if (stressConfig.enabled) {
+        frameStats.Print();
+        std::cout << "Projectiles dropped by full lane stores: " << sim.world.DroppedProjectileCount() << std::endl;
+        std::cout << "Board rebuilt " << stress.restarts << " times after the zombies broke through" << std::endl;
+    }
+    if (stressConfig.enabled || printJobStats) {
+        jobs.PrintStats();
     }
 
     UnloadSound(shootSound);
@@ -726,22 +869,15 @@ int main() {
     UnloadSound(digSound);
     UnloadMusicStream(backgroundMusic);
 
-    UnloadTexture(peashooterTex);
-    UnloadTexture(sunflowerTex);
-    UnloadTexture(cherryBombTex);
-    UnloadTexture(wallnutTex);
-    UnloadTexture(regularZombieTex);
-    UnloadTexture(jumpingZombieTex);
-    UnloadTexture(peaTex);
     UnloadTexture(grassBackgroundTex);
-    UnloadTexture(pauseButtonTex);
     UnloadTexture(mainMenuBackgroundTex);
-    UnloadTexture(lawnmowerTex);
     UnloadTexture(levelUpTex);
-    UnloadTexture(shovelTex);
-    UnloadTexture(repeaterTex);
-    UnloadTexture(icePeaPlantTex);
-    UnloadTexture(icePeaProjectileTex);
+    atlas.Unload();
+    UnloadHudCache(hud);
+    UnloadBackgroundCache(background);
+    for (Texture2D texture: looseSpriteTextures) {
+        UnloadTexture(texture);
+    }
 
     CloseAudioDevice();
     CloseWindow();
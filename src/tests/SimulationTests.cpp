@@ -0,0 +1,278 @@
+// simulation_tests.cpp
+// pvz_tests: headless behaviour checks for the gameplay rules (projectile hits, damage
+// commit, zombie range queries, lane-parallel stepping). Runs on the pvz_sim library only,
+// so no window, GPU or audio device is needed. Registered with CTest.
+//
+// Usage: pvz_tests [<name substring>]
+
+#include "raylib.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "GameConstants.h"
+#include "DamageEvents.h"
+#include "ProjectileCollision.h"
+#include "Simulation.h"
+#include "JobSystem.h"
+#include "World.h"
+
+//----------------------------------------------------------------------------------
+// Harness
+//----------------------------------------------------------------------------------
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("    FAILED %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures; \
+        } \
+    } while (0)
+
+// A Simulation with an empty lawn and no wave spawner, for placing things by hand
+static void ClearBoard(Simulation &sim) {
+    sim.world.Clear();
+    sim.zombieSpawnRate = 1e9f;
+    sim.zombieSpawnTimer = 0.0f;
+}
+
+// Adds a regular zombie with the given rect straight into a lane
+static Zombie *AddZombie(Simulation &sim, int row, Rectangle rect) {
+    Lane &lane = sim.world.GetLane(row);
+    Zombie *zombie = EmplaceEntity(lane.regularZombies, rect, row, sim.animations.regularZombie, 1);
+    lane.InsertZombie(zombie);
+    return zombie;
+}
+
+//----------------------------------------------------------------------------------
+// Projectile Hits
+//----------------------------------------------------------------------------------
+// A pea fired at normal speed, stepped at the fixed 120 Hz tick, lands exactly one hit
+static void TestPeaHitsAtTickRate() {
+    Simulation sim;
+    ClearBoard(sim);
+    const BoardConfig &board = sim.world.board;
+
+    Zombie *zombie = sim.SpawnZombie(ZombieType::REGULAR, 2, board.TileX(6));
+    int startHealth = zombie->health;
+    Lane &lane = sim.world.GetLane(2);
+    lane.projectiles.Spawn(board.TileX(0), zombie->rect.y + zombie->rect.height / 4, PROJECTILE_SPEED, PEA_DAMAGE,
+                           ProjectileType::NORMAL);
+
+    for (int tick = 0; tick < 10 * (int) SIM_TICK_RATE && lane.projectiles.Count() > 0; ++tick) {
+        sim.Step(1.0f / SIM_TICK_RATE);
+    }
+    CHECK(lane.projectiles.Count() == 0);
+    CHECK(zombie->health == startHealth - PEA_DAMAGE);
+}
+
+// A pea that moves further than the zombie is wide in one tick still hits it
+static void TestFastPeaDoesNotTunnel() {
+    Simulation sim;
+    ClearBoard(sim);
+    const BoardConfig &board = sim.world.board;
+
+    Zombie *zombie = sim.SpawnZombie(ZombieType::REGULAR, 1, board.TileX(5));
+    Lane &lane = sim.world.GetLane(1);
+    float stride = 3.0f * (zombie->rect.width + PROJECTILE_WIDTH); // Pixels per tick
+    float startX = zombie->rect.x - PROJECTILE_WIDTH - 1.0f;
+    lane.projectiles.Spawn(startX, zombie->rect.y + zombie->rect.height / 4, stride * SIM_TICK_RATE, PEA_DAMAGE,
+                           ProjectileType::NORMAL);
+
+    ProjectileCollisionResult result = RunProjectileCollisionStage(lane, 1.0f / SIM_TICK_RATE, board.fieldRight);
+    CHECK(result.hits == 1);
+    CHECK(lane.damage.Count() == 1 && lane.damage.events[0].target == zombie);
+}
+
+// A 1x100 lane with a Repeater on every tile, firing for 20 s at a zombie parked past the
+// edge of the field, keeps every shot: the lane store grows to what the board can hold
+static void TestFullLaneKeepsEveryShot() {
+    const int cols = 100;
+    Simulation sim(SimulationAssets(), SIM_TICK_RATE, BoardConfig::WithSize(1, cols));
+    ClearBoard(sim);
+    const BoardConfig &board = sim.world.board;
+
+    sim.sunCurrency = 1 << 30;
+    for (int col = 0; col < cols; ++col) sim.PlacePlant(PlantType::REPEATER, 0, col);
+    Zombie *target = AddZombie(sim, 0, {board.fieldRight + board.tileSize, board.TileY(0), 60, 100});
+    target->speed = 0.0f;
+
+    for (int tick = 0; tick < 20 * (int) SIM_TICK_RATE; ++tick) sim.Step(1.0f / SIM_TICK_RATE);
+
+    const ProjectileStore &projectiles = sim.world.GetLane(0).projectiles;
+    CHECK(projectiles.DroppedCount() == 0);
+    CHECK(projectiles.TotalSpawned() >= (size_t) (cols * 2 * 19)); // Two peas a second, less the first volley's wait
+    CHECK(projectiles.Capacity() <= board.MaxLaneProjectiles());
+}
+
+//----------------------------------------------------------------------------------
+// Damage Commit
+//----------------------------------------------------------------------------------
+// A pea hit, a Cherry Bomb blast and a mower on the same zombie in one tick score it once
+static void TestCommitScoresOnce() {
+    Simulation sim;
+    ClearBoard(sim);
+    Zombie *zombie = AddZombie(sim, 0, {400, 100, 50, 100});
+
+    DamageQueue queue;
+    queue.Damage(zombie, PEA_DAMAGE);
+    queue.Damage(zombie, 9999);
+    queue.Kill(zombie);
+    queue.Damage(zombie, PEA_DAMAGE);
+
+    CHECK(queue.Commit() == zombie->scoreValue);
+    CHECK(!zombie->active);
+    CHECK(queue.Count() == 0);
+}
+
+// A blast queued in the plant phase (on the neighbouring lane's queue, as a Cherry Bomb
+// does) makes the peas of the zombie phase fly past the doomed zombie instead of being
+// spent on it, and the zombie is still scored exactly once
+static void TestPendingBlastLetsPeasThrough() {
+    Simulation sim;
+    ClearBoard(sim);
+    const BoardConfig &board = sim.world.board;
+
+    Zombie *zombie = AddZombie(sim, 2, {board.TileX(5), board.TileY(2), 60, 100});
+    Lane &lane = sim.world.GetLane(2);
+    lane.projectiles.Spawn(zombie->rect.x - PROJECTILE_WIDTH, zombie->rect.y + 10, PROJECTILE_SPEED, PEA_DAMAGE,
+                           ProjectileType::NORMAL);
+
+    sim.world.QueueDamage(1, zombie, 9999);
+    for (auto &each: sim.world.lanes) each.damage.MarkPending();
+
+    ProjectileCollisionResult result = RunProjectileCollisionStage(lane, 1.0f / SIM_TICK_RATE, board.fieldRight);
+    CHECK(result.hits == 0);
+    CHECK(lane.projectiles.Count() == 1);
+
+    int score = 0;
+    for (auto &each: sim.world.lanes) score += each.damage.Commit();
+    CHECK(score == zombie->scoreValue);
+    CHECK(!zombie->active);
+    CHECK(zombie->pendingDamage == 0);
+}
+
+//----------------------------------------------------------------------------------
+// Range Queries
+//----------------------------------------------------------------------------------
+// A zombie much wider than its neighbours starts far left of the range but still overlaps it
+static void TestRangeQueryFindsWideZombie() {
+    Simulation sim;
+    ClearBoard(sim);
+
+    Zombie *wide = AddZombie(sim, 3, {0, 100, 500, 100});
+    Zombie *first = AddZombie(sim, 3, {100, 100, 50, 100});
+    AddZombie(sim, 3, {200, 100, 50, 100});
+    AddZombie(sim, 3, {300, 100, 50, 100});
+
+    std::vector<Zombie *> found;
+    auto collect = [&found](Zombie &zombie) { found.push_back(&zombie); };
+
+    CHECK(sim.world.ForEachZombieInRange(3, 3, 450, 460, collect) == 1);
+    CHECK(found.size() == 1 && found[0] == wide);
+
+    found.clear();
+    CHECK(sim.world.ForEachZombieInRange(3, 3, 120, 130, collect) == 2);
+    CHECK(found.size() == 2 && found[0] == wide && found[1] == first);
+
+    // Neighbouring rows are clamped to the board and hold nothing
+    found.clear();
+    CHECK(sim.world.ForEachZombieInRange(-1, 2, 0, 1000, collect) == 0);
+    CHECK(found.empty());
+}
+
+//----------------------------------------------------------------------------------
+// Lane-Parallel Stepping
+//----------------------------------------------------------------------------------
+// Everything about a run that parallel stepping could get wrong
+struct RunState {
+    int score, sunCurrency;
+    bool gameOver;
+    std::vector<float> zombies; // x, y and health of every zombie, lane by lane, in lane order
+    std::vector<size_t> plants, projectiles; // Per lane
+
+    bool operator==(const RunState &other) const {
+        return score == other.score && sunCurrency == other.sunCurrency && gameOver == other.gameOver &&
+               zombies == other.zombies && plants == other.plants && projectiles == other.projectiles;
+    }
+};
+
+static RunState RunSeededGame(JobSystem *jobs) {
+    SetRandomSeed(42);
+    Simulation sim;
+    sim.jobs = jobs;
+    sim.Reset(3);
+    sim.sunCurrency = 100000;
+    for (int row = 0; row < sim.world.Rows(); ++row) {
+        for (int col = 0; col < 6; ++col) {
+            PlantType type = col % 3 == 0 ? PlantType::REPEATER
+                             : col % 3 == 1 ? PlantType::ICE_PEA
+                             : PlantType::PEASHOOTER;
+            sim.PlacePlant(type, row, col);
+        }
+    }
+    sim.PlacePlant(PlantType::WALNUT, 2, 7);
+    sim.PlacePlant(PlantType::CHERRY_BOMB, 1, 8);
+    sim.PlacePlant(PlantType::SUNFLOWER, 0, 8);
+
+    for (int tick = 0; tick < 60 * (int) SIM_TICK_RATE && !sim.gameOver; ++tick) {
+        sim.Step(1.0f / SIM_TICK_RATE);
+    }
+
+    RunState state = {sim.score, sim.sunCurrency, sim.gameOver, {}, {}, {}};
+    for (const Lane &lane: sim.world.lanes) {
+        for (const Zombie *zombie: lane.zombies) {
+            state.zombies.insert(state.zombies.end(), {zombie->rect.x, zombie->rect.y, (float) zombie->health});
+        }
+        state.plants.push_back(lane.PlantCount());
+        state.projectiles.push_back(lane.projectiles.Count());
+    }
+    return state;
+}
+
+static void TestParallelMatchesSerial() {
+    RunState serial = RunSeededGame(nullptr);
+    JobSystem jobs(4);
+    RunState parallel = RunSeededGame(&jobs);
+
+    CHECK(serial.score > 0); // The run has to have done something worth comparing
+    CHECK(serial.score == parallel.score);
+    CHECK(serial.sunCurrency == parallel.sunCurrency);
+    CHECK(serial.zombies == parallel.zombies);
+    CHECK(serial == parallel);
+}
+
+//----------------------------------------------------------------------------------
+// Main
+//----------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    SetTraceLogLevel(LOG_WARNING);
+    const char *filter = argc > 1 ? argv[1] : nullptr;
+
+    struct Test {
+        const char *name;
+        void (*run)();
+    };
+    const Test tests[] = {
+        {"projectile/hits_at_tick_rate", TestPeaHitsAtTickRate},
+        {"projectile/fast_pea_does_not_tunnel", TestFastPeaDoesNotTunnel},
+        {"projectile/full_lane_keeps_every_shot", TestFullLaneKeepsEveryShot},
+        {"damage/commit_scores_once", TestCommitScoresOnce},
+        {"damage/pending_blast_lets_peas_through", TestPendingBlastLetsPeasThrough},
+        {"query/range_finds_wide_zombie", TestRangeQueryFindsWideZombie},
+        {"step/parallel_matches_serial", TestParallelMatchesSerial},
+    };
+
+    int run = 0;
+    for (const Test &test: tests) {
+        if (filter && std::strstr(test.name, filter) == nullptr) continue;
+        int failuresBefore = failures;
+        test.run();
+        std::printf("%-45s %s\n", test.name, failures == failuresBefore ? "ok" : "FAILED");
+        ++run;
+    }
+    std::printf("%d tests, %d failed checks\n", run, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,330 @@
+// benchmark.cpp
+// pvz_bench: headless micro and macro benchmarks for the gameplay hot paths.
+// Runs on the pvz_sim library only, so no window, GPU or audio device is needed.
+//
+// Usage: pvz_bench [--filter <substring>] [--min-time <seconds>]
+
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GameConstants.h"
+#include "Simulation.h"
+#include "JobSystem.h"
+#include "World.h"
+
+//----------------------------------------------------------------------------------
+// Harness
+//----------------------------------------------------------------------------------
+struct BenchOptions {
+    const char *filter = nullptr;
+    double minTime = 0.25; // Seconds each case is repeated for
+};
+
+static BenchOptions options;
+static volatile long long benchSink = 0; // Keeps results alive so the optimizer cannot drop the work
+static size_t droppedShots = 0; // Peas the tick cases lost to full lane stores, reported at the end
+
+using Clock = std::chrono::steady_clock;
+
+static bool Selected(const std::string &name) {
+    return !options.filter || name.find(options.filter) != std::string::npos;
+}
+
+// Runs op() in batches until minTime has been spent, then prints ns per call and entities
+// per second (entitiesPerOp says how many entities one call touches). setup() runs before
+// every batch and is not timed; cases without a setup double their batch size while the
+// batches are still too short to time reliably.
+static void RunCase(const std::string &name, double entitiesPerOp,
+                    const std::function<void()> &setup, const std::function<void()> &op, long long batch = 1) {
+    if (!Selected(name)) return;
+
+    long long totalOps = 0;
+    double totalSeconds = 0.0;
+    while (totalSeconds < options.minTime) {
+        if (setup) setup();
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < batch; ++i) op();
+        totalSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+        totalOps += batch;
+        if (!setup && totalSeconds < options.minTime / 10 && batch < (1LL << 30)) batch *= 2;
+    }
+
+    double nsPerOp = totalSeconds * 1e9 / totalOps;
+    double entitiesPerSecond = entitiesPerOp * totalOps / totalSeconds;
+    std::printf("%-40s %12lld ops %14.1f ns/op %16.0f entities/s\n",
+                name.c_str(), totalOps, nsPerOp, entitiesPerSecond);
+}
+
+//----------------------------------------------------------------------------------
+// Scenario helpers
+//----------------------------------------------------------------------------------
+static std::mt19937 rng(1234);
+
+static float RandomFloat(float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(rng);
+}
+
+// Puts zombiesPerLane zombies in every lane, spread over [fromX, toX)
+static void FillZombies(Simulation &sim, int zombiesPerLane, float fromX, float toX) {
+    for (int row = 0; row < GRID_ROWS; ++row) {
+        for (int i = 0; i < zombiesPerLane; ++i) {
+            ZombieType type = (i % 2 == 0) ? ZombieType::REGULAR : ZombieType::JUMPING;
+            sim.SpawnZombie(type, row, fromX + (toX - fromX) * i / zombiesPerLane);
+        }
+    }
+}
+
+// A board with roughly `entities` plants and zombies: up to a quarter plants (capped at
+// the lawn size), the rest zombies marching in from the right.
+static void PopulateBoard(Simulation &sim, int entities) {
+    static const PlantType mix[] = {PlantType::PEASHOOTER, PlantType::REPEATER, PlantType::ICE_PEA, PlantType::WALNUT};
+
+    sim.Reset(1);
+    sim.sunCurrency = 1 << 30;
+
+    const BoardConfig &board = sim.world.board;
+    int plants = std::min(entities / 4, board.rows * board.cols);
+    for (int i = 0; i < plants; ++i) {
+        sim.PlacePlant(mix[i % 4], i % board.rows, i / board.rows);
+    }
+
+    int zombies = entities - plants;
+    for (int i = 0; i < zombies; ++i) {
+        ZombieType type = (i % 2 == 0) ? ZombieType::REGULAR : ZombieType::JUMPING;
+        sim.SpawnZombie(type, i % board.rows, board.fieldRight * 0.6f + (i / board.rows) * 8.0f);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Benchmarks
+//----------------------------------------------------------------------------------
+static void BenchZombieLaneScan() {
+    for (int perLane: {10, 100, 1000}) {
+        Simulation sim;
+        sim.Reset(1);
+        sim.world.Clear();
+        FillZombies(sim, perLane, SCREEN_WIDTH * 0.5f, SCREEN_WIDTH * 1.5f);
+
+        std::vector<float> queries(1024);
+        for (float &q: queries) q = RandomFloat((float) GRID_START_X, (float) SCREEN_WIDTH * 1.6f);
+
+        size_t next = 0;
+        RunCase("lane_scan/has_zombie_ahead/" + std::to_string(perLane), perLane, nullptr, [&]() {
+            int row = (int) (next % GRID_ROWS);
+            benchSink += sim.world.HasZombieAhead(row, queries[next++ & 1023]);
+        }, 1024);
+    }
+}
+
+static void BenchProjectileCollision() {
+    for (int perLane: {10, 100, 1000}) {
+        Simulation sim;
+        sim.Reset(1);
+        sim.world.Clear();
+        FillZombies(sim, perLane, SCREEN_WIDTH * 0.5f, SCREEN_WIDTH * 1.5f);
+
+        for (auto &lane: sim.world.lanes) lane.hitboxes.Build(lane.zombies);
+
+        RunCase("collision/build_hitboxes/" + std::to_string(perLane), perLane * GRID_ROWS, nullptr, [&]() {
+            for (auto &lane: sim.world.lanes) lane.hitboxes.Build(lane.zombies);
+            benchSink += (long long) sim.world.lanes[0].hitboxes.left.size();
+        });
+
+        std::vector<Vector2> shots(1024);
+        for (Vector2 &shot: shots) {
+            int row = (int) (rng() % GRID_ROWS);
+            shot = {RandomFloat((float) GRID_START_X, (float) SCREEN_WIDTH * 1.6f),
+                    GRID_START_Y + row * TILE_SIZE + TILE_SIZE * 0.475f};
+        }
+
+        size_t next = 0;
+        RunCase("collision/first_overlap/" + std::to_string(perLane), perLane, nullptr, [&]() {
+            const Vector2 &shot = shots[next & 1023];
+            const ZombieHitboxes &hitboxes = sim.world.lanes[next % GRID_ROWS].hitboxes;
+            benchSink += hitboxes.FirstOverlap(shot.x, shot.y, PROJECTILE_WIDTH, PROJECTILE_HEIGHT);
+            ++next;
+        }, 1024);
+    }
+}
+
+static void BenchPlacementLookup() {
+    Simulation sim;
+    sim.Reset(1);
+    sim.sunCurrency = 1 << 30;
+    for (int row = 0; row < GRID_ROWS; ++row) {
+        for (int col = 0; col < GRID_COLS; col += 2) {
+            sim.PlacePlant(PlantType::WALNUT, row, col);
+        }
+    }
+
+    size_t next = 0;
+    RunCase("placement/plant_at", 1, nullptr, [&]() {
+        int tile = (int) (next++ % (GRID_ROWS * GRID_COLS));
+        benchSink += sim.world.PlantAt(tile / GRID_COLS, tile % GRID_COLS) != nullptr;
+    }, 1024);
+
+    // RemovePlant only deactivates the plant, so the lane is compacted every time as the end of
+    // tick would; otherwise dead Wall-nuts pile up and the case times the bucket growing
+    next = 0;
+    RunCase("placement/place_and_shovel", 1, nullptr, [&]() {
+        int row = (int) (next % GRID_ROWS);
+        int col = 1 + 2 * (int) ((next / GRID_ROWS) % (GRID_COLS / 2));
+        benchSink += sim.PlacePlant(PlantType::WALNUT, row, col);
+        benchSink += sim.RemovePlant(row, col);
+        sim.world.CompactLane(row);
+        ++next;
+    }, 1024);
+
+    next = 0;
+    Rectangle zombieRect = {0, 0, TILE_SIZE / 2.0f * 2.8f, TILE_SIZE / 2.0f * 2.8f};
+    RunCase("placement/plant_touching", 1, nullptr, [&]() {
+        int row = (int) (next % GRID_ROWS);
+        zombieRect.x = GRID_START_X + (float) (next % (GRID_COLS * TILE_SIZE));
+        zombieRect.y = GRID_START_Y + row * TILE_SIZE + TILE_SIZE / 4.0f;
+        benchSink += sim.world.PlantTouching(row, zombieRect) != nullptr;
+        ++next;
+    }, 1024);
+}
+
+static void BenchFullTick() {
+    const int ticksPerRun = 240; // Two seconds of game time at the default tick rate
+
+    for (int entities: {10, 100, 1000, 10000}) {
+        Simulation sim;
+
+        RunCase("tick/full/" + std::to_string(entities), (double) entities * ticksPerRun, [&]() {
+            PopulateBoard(sim, entities);
+        }, [&]() {
+            for (int t = 0; t < ticksPerRun; ++t) sim.Step(sim.FixedDeltaTime());
+            benchSink += sim.score;
+        });
+
+        // Report per tick rather than per run so the numbers read as frame budgets
+        RunCase("tick/per_tick/" + std::to_string(entities), entities, [&]() {
+            PopulateBoard(sim, entities);
+        }, [&]() {
+            sim.Step(sim.FixedDeltaTime());
+            benchSink += sim.score;
+        }, ticksPerRun);
+        droppedShots += sim.world.DroppedProjectileCount();
+    }
+}
+
+// The same per-tick case with the lanes stepped as jobs
+static void BenchParallelTick(JobSystem &jobs) {
+    const int ticksPerRun = 240;
+    int threads = jobs.ThreadCount();
+
+    for (int entities: {1000, 10000}) {
+        Simulation sim;
+        sim.jobs = &jobs;
+        RunCase("tick/per_tick_threads" + std::to_string(threads) + "/" + std::to_string(entities), entities, [&]() {
+            PopulateBoard(sim, entities);
+        }, [&]() {
+            sim.Step(sim.FixedDeltaTime());
+            benchSink += sim.score;
+        }, ticksPerRun);
+        droppedShots += sim.world.DroppedProjectileCount();
+    }
+}
+
+// Large arenas: a quarter of the tiles planted, lanes stepped as jobs
+static void BenchArenaTick(JobSystem &jobs) {
+    const int ticksPerRun = 240;
+    struct Arena { int rows, cols; };
+
+    for (Arena arena: {Arena{20, 100}, Arena{100, 1000}}) {
+        std::string size = std::to_string(arena.rows) + "x" + std::to_string(arena.cols);
+        if (!Selected("tick/arena/" + size)) continue;
+
+        Simulation sim(SimulationAssets(), SIM_TICK_RATE, BoardConfig::WithSize(arena.rows, arena.cols));
+        sim.jobs = &jobs;
+        int entities = arena.rows * arena.cols;
+        RunCase("tick/arena/" + size, entities, [&]() {
+            PopulateBoard(sim, entities);
+        }, [&]() {
+            sim.Step(sim.FixedDeltaTime());
+            benchSink += sim.score;
+        }, ticksPerRun);
+        droppedShots += sim.world.DroppedProjectileCount();
+    }
+}
+
+// Scheduler overhead: an empty parallel_for, and a loop with enough work per index to spread
+static void BenchJobSystem(JobSystem &jobs) {
+    RunCase("jobs/parallel_for_empty/64", 64, nullptr, [&]() {
+        jobs.ParallelFor(64, [](int) {});
+        benchSink += 64;
+    });
+
+    std::vector<float> values(1 << 16);
+    RunCase("jobs/parallel_for_work/65536", (double) values.size(), nullptr, [&]() {
+        jobs.ParallelFor((int) values.size(), [&values](int i) {
+            values[i] = values[i] * 0.5f + (float) i;
+        }, 4096);
+        benchSink += (long long) values[values.size() - 1];
+    });
+
+    // Per-worker balance over the two cases above
+    if (Selected("jobs/parallel_for_empty/64") || Selected("jobs/parallel_for_work/65536")) {
+        jobs.PrintStats();
+    }
+    jobs.ResetStats();
+}
+
+static void BenchLevelReset() {
+    Simulation sim;
+    int level = 1;
+    RunCase("reset/level", GRID_ROWS, nullptr, [&]() {
+        sim.Reset(level);
+        level = level % 10 + 1;
+        benchSink += sim.world.ZombieCount();
+    }, 64);
+
+    RunCase("reset/populated_board_1000", 1000, [&]() {
+        PopulateBoard(sim, 1000);
+    }, [&]() {
+        sim.Reset(1);
+        benchSink += sim.world.ZombieCount();
+    });
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            options.minTime = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: %s [--filter <substring>] [--min-time <seconds>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetRandomSeed(1234);
+
+    std::printf("%-40s %16s %20s %27s\n", "benchmark", "iterations", "time", "throughput");
+    BenchZombieLaneScan();
+    BenchProjectileCollision();
+    BenchPlacementLookup();
+    BenchFullTick();
+
+    JobSystem jobs(std::max(2, (int) std::thread::hardware_concurrency()));
+    BenchJobSystem(jobs);
+    BenchParallelTick(jobs);
+    BenchArenaTick(jobs);
+    BenchLevelReset();
+
+    std::printf("projectiles dropped by full lane stores: %zu\n", droppedShots);
+    return 0;
+}